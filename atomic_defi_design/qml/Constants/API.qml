@@ -169,6 +169,7 @@ QtObject {
         },
 
         initial_loading_status: "initializing_mm2",
+        activation_progress: ({ enabled: 0, total: 0 }),
 
         prepare_send: (address, amount, max=true) => {
            console.log("Preparing to send " + amount + " to " + address)
@@ -149,6 +149,7 @@ Item {
         legend.visible: false
         backgroundColor: "transparent"
 
+        onPlotAreaChanged: cs_mapper.model.visible_width = plotArea.width
 
         Timer {
             id: update_last_value_y_timer
@@ -13,6 +13,7 @@ SetupPage {
     property var onLoaded: () => {}
 
     readonly property string current_status: API.get().initial_loading_status
+    readonly property var activation_progress: API.get().activation_progress
 
     onCurrent_statusChanged: {
         if(current_status === "complete")
@@ -39,7 +40,9 @@ SetupPage {
 
             DefaultText {
                 text_value: API.get().settings_pg.empty_string + ((current_status === "initializing_mm2" ? qsTr("Initializing MM2") :
-                       current_status === "enabling_coins" ? qsTr("Enabling coins") : qsTr("Getting ready")) + "...")
+                       current_status === "enabling_coins" ? qsTr("Enabling coins") : qsTr("Getting ready")) + "..." +
+                       (current_status === "enabling_coins" && activation_progress.total > 0 ?
+                            " (" + activation_progress.enabled + "/" + activation_progress.total + ")" : ""))
             }
         }
     }
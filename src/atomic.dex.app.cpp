@@ -45,6 +45,7 @@
 #include "atomic.dex.qt.settings.page.hpp"
 #include "atomic.dex.qt.utilities.hpp"
 #include "atomic.dex.security.hpp"
+#include "atomic.dex.startup.tracer.hpp"
 #include "atomic.dex.update.service.hpp"
 #include "atomic.dex.utilities.hpp"
 #include "atomic.dex.version.hpp"
@@ -136,16 +137,11 @@ namespace atomic_dex
     {
         if (not get_orders()->swap_is_in_progress(coins[0]))
         {
+            //! The models are updated once mm2 confirmed which coins are disabled
             std::vector<std::string> coins_std;
-            system_manager_.get_system<portfolio_page>().get_portfolio()->disable_coins(coins);
-            system_manager_.get_system<trading_page>().disable_coin(coins[0]);
             coins_std.reserve(coins.size());
             for (auto&& coin: coins) { coins_std.push_back(coin.toStdString()); }
             get_mm2().disable_multiple_coins(coins_std);
-            if (m_coin_info->get_ticker() == coins[0] && m_kmd_fully_enabled)
-            {
-                m_coin_info->set_ticker("KMD");
-            }
         }
 
         return false;
@@ -212,22 +208,10 @@ namespace atomic_dex
         }
         auto& mm2     = get_mm2();
         auto& paprika = get_paprika();
-        if (mm2.is_mm2_running())
+        //! Fiat values are refreshed by the balance and rates actions, not on every frame
+        if (mm2.is_mm2_running() && not m_coin_info->get_ticker().isEmpty() && not m_enabled_coins.empty())
         {
-            std::error_code ec;
-            const auto&     config           = system_manager_.get_system<settings_page>().get_cfg();
-            auto            fiat_balance_std = paprika.get_price_in_fiat_all(config.current_currency, ec);
-
-            if (!ec)
-            {
-                this->set_current_balance_fiat_all(QString::fromStdString(fiat_balance_std));
-            }
-
-            if (not m_coin_info->get_ticker().isEmpty() && not m_enabled_coins.empty())
-            {
-                refresh_fiat_balance(mm2, paprika);
-                refresh_address(mm2);
-            }
+            refresh_address(mm2);
         }
 
         system_manager_.get_system<trading_page>().process_action();
@@ -260,7 +244,28 @@ namespace atomic_dex
             case action::refresh_portfolio_ticker_balance:
                 if (mm2.is_mm2_running())
                 {
-                    system_manager_.get_system<portfolio_page>().get_portfolio()->update_balance_values(*m_ticker_balance_to_refresh);
+                    const std::string ticker = m_ticker_balance_to_refresh.get();
+                    system_manager_.get_system<portfolio_page>().get_portfolio()->update_balance_values(ticker);
+                    refresh_fiat_balance_all(paprika);
+                    if (m_coin_info->get_ticker().toStdString() == ticker)
+                    {
+                        refresh_fiat_balance(mm2, paprika);
+                    }
+                }
+                break;
+            case action::refresh_rates:
+                if (mm2.is_mm2_running())
+                {
+                    this->process_refresh_rates_action();
+                }
+                break;
+            case action::refresh_activation_progress:
+                emit activationProgressChanged();
+                break;
+            case action::post_process_coins_disabled:
+                if (mm2.is_mm2_running())
+                {
+                    this->process_coins_disabled_action();
                 }
                 break;
             case action::post_process_orders_finished:
@@ -307,6 +312,18 @@ namespace atomic_dex
         }
     }
 
+    void
+    application::refresh_fiat_balance_all(const coinpaprika_provider& paprika)
+    {
+        std::error_code ec;
+        const auto&     config           = system_manager_.get_system<settings_page>().get_cfg();
+        const auto      fiat_balance_std = paprika.get_price_in_fiat_all(config.current_currency, ec);
+        if (!ec && QString::fromStdString(fiat_balance_std) != m_current_balance_all)
+        {
+            this->set_current_balance_fiat_all(QString::fromStdString(fiat_balance_std));
+        }
+    }
+
     void
     application::refresh_transactions(const mm2& mm2)
     {
@@ -452,6 +469,7 @@ namespace atomic_dex
                 process_refresh_current_ticker_infos();
             }
             this->set_status("complete");
+            get_startup_tracer().end_session(get_atomic_dex_current_startup_trace_file());
         }
     }
 
@@ -595,11 +613,21 @@ namespace atomic_dex
     }
 
     void
-    application::on_coin_disabled_event([[maybe_unused]] const coin_disabled& evt) noexcept
+    application::on_coins_disabled_event(const coins_disabled& evt) noexcept
     {
         spdlog::debug("{} l{}", __FUNCTION__, __LINE__);
+        bool need_action = false;
+        {
+            auto pending = m_disabled_tickers.synchronize();
+            need_action  = pending->empty();
+            pending->insert(pending->end(), evt.tickers.begin(), evt.tickers.end());
+        }
         if (not m_event_actions[events_action::about_to_exit_app])
         {
+            if (need_action)
+            {
+                this->m_actions_queue.push(action::post_process_coins_disabled);
+            }
             this->m_actions_queue.push(action::refresh_enabled_coin);
         }
     }
@@ -625,6 +653,25 @@ namespace atomic_dex
         emit onStatusChanged();
     }
 
+    QVariantMap
+    application::get_activation_progress() const noexcept
+    {
+        const coins_activation_progress progress = m_activation_progress.get();
+        return {{"enabled", static_cast<qulonglong>(progress.nb_enabled)}, {"total", static_cast<qulonglong>(progress.nb_total)}};
+    }
+
+    void
+    application::on_coins_activation_progress_event(const coins_activation_progress& evt) noexcept
+    {
+        //! Sent from the enabling threads, the QML side is notified from the next tick
+        spdlog::trace("{} l{} enabled {}/{}", __FUNCTION__, __LINE__, evt.nb_enabled, evt.nb_total);
+        m_activation_progress = evt;
+        if (not m_event_actions[events_action::about_to_exit_app])
+        {
+            this->m_actions_queue.push(action::refresh_activation_progress);
+        }
+    }
+
     void
     application::on_mm2_initialized_event([[maybe_unused]] const mm2_initialized& evt) noexcept
     {
@@ -687,6 +734,8 @@ namespace atomic_dex
             [[maybe_unused]] action act;
             this->m_actions_queue.pop(act);
         }
+        m_disabled_tickers.synchronize()->clear();
+        *m_rates_to_refresh.synchronize() = rates_updated{};
 
         //! Clear models
         addressbook_model* addressbook = qobject_cast<addressbook_model*>(m_manager_models.at("addressbook"));
@@ -719,19 +768,25 @@ namespace atomic_dex
         get_dispatcher().sink<enabled_default_coins_event>().disconnect<&application::on_enabled_default_coins_event>(*this);
         get_dispatcher().sink<coin_fully_initialized>().disconnect<&application::on_coin_fully_initialized_event>(*this);
         get_dispatcher().sink<tx_fetch_finished>().disconnect<&application::on_tx_fetch_finished_event>(*this);
-        get_dispatcher().sink<coin_disabled>().disconnect<&application::on_coin_disabled_event>(*this);
+        get_dispatcher().sink<coins_disabled>().disconnect<&application::on_coins_disabled_event>(*this);
         get_dispatcher().sink<mm2_initialized>().disconnect<&application::on_mm2_initialized_event>(*this);
         get_dispatcher().sink<mm2_started>().disconnect<&application::on_mm2_started_event>(*this);
         get_dispatcher().sink<process_orders_finished>().disconnect<&application::on_process_orders_finished_event>(*this);
         get_dispatcher().sink<process_swaps_finished>().disconnect<&application::on_process_swaps_finished_event>(*this);
+        get_dispatcher().sink<rates_updated>().disconnect<&application::on_rates_updated_event>(*this);
+        get_dispatcher().sink<coins_activation_progress>().disconnect<&application::on_coins_activation_progress_event>(*this);
+        get_dispatcher().sink<update_portfolio_values>().disconnect<&application::on_update_portfolio_values_event>(*this);
 
         m_event_actions[events_action::need_a_full_refresh_of_mm2] = true;
 
+        //! Keep the exported wallet in sync with the address book edits of the session
+        this->m_wallet_manager.export_wallet_cfg();
         this->m_wallet_manager.just_set_wallet_name("");
         emit onWalletDefaultNameChanged();
 
         this->m_btc_fully_enabled = false;
         this->m_kmd_fully_enabled = false;
+        this->m_activation_progress = coins_activation_progress{};
         this->set_status("None");
         return fs::remove(get_atomic_dex_config_folder() / "default.wallet");
     }
@@ -748,11 +803,14 @@ namespace atomic_dex
         get_dispatcher().sink<enabled_default_coins_event>().connect<&application::on_enabled_default_coins_event>(*this);
         get_dispatcher().sink<coin_fully_initialized>().connect<&application::on_coin_fully_initialized_event>(*this);
         get_dispatcher().sink<tx_fetch_finished>().connect<&application::on_tx_fetch_finished_event>(*this);
-        get_dispatcher().sink<coin_disabled>().connect<&application::on_coin_disabled_event>(*this);
+        get_dispatcher().sink<coins_disabled>().connect<&application::on_coins_disabled_event>(*this);
         get_dispatcher().sink<mm2_initialized>().connect<&application::on_mm2_initialized_event>(*this);
         get_dispatcher().sink<mm2_started>().connect<&application::on_mm2_started_event>(*this);
         get_dispatcher().sink<process_orders_finished>().connect<&application::on_process_orders_finished_event>(*this);
         get_dispatcher().sink<process_swaps_finished>().connect<&application::on_process_swaps_finished_event>(*this);
+        get_dispatcher().sink<rates_updated>().connect<&application::on_rates_updated_event>(*this);
+        get_dispatcher().sink<coins_activation_progress>().connect<&application::on_coins_activation_progress_event>(*this);
+        get_dispatcher().sink<update_portfolio_values>().connect<&application::on_update_portfolio_values_event>(*this);
     }
 
     QString
@@ -951,7 +1009,7 @@ namespace atomic_dex
     QVariantList
     application::get_all_coins() const noexcept
     {
-        return to_qt_binding(get_mm2().get_all_coins());
+        return to_qt_binding(t_coins(*get_mm2().get_all_coins()));
     }
 
     QString
@@ -1015,6 +1073,36 @@ namespace atomic_dex
 //! Ticker balance change
 namespace atomic_dex
 {
+    void
+    application::on_rates_updated_event(const rates_updated& evt) noexcept
+    {
+        spdlog::trace("{} l{}", __FUNCTION__, __LINE__);
+        bool need_action = false;
+        {
+            //! A single action is queued until the pending changes are applied
+            auto pending = m_rates_to_refresh.synchronize();
+            need_action  = pending->tickers.empty() && pending->currencies.empty();
+            pending->tickers.insert(pending->tickers.end(), evt.tickers.begin(), evt.tickers.end());
+            pending->currencies.insert(pending->currencies.end(), evt.currencies.begin(), evt.currencies.end());
+        }
+        if (need_action && not m_event_actions[events_action::about_to_exit_app])
+        {
+            this->m_actions_queue.push(action::refresh_rates);
+        }
+    }
+
+    void
+    application::on_update_portfolio_values_event([[maybe_unused]] const update_portfolio_values& evt) noexcept
+    {
+        //! The current currency changed, every fiat value is displayed in it
+        spdlog::trace("{} l{}", __FUNCTION__, __LINE__);
+        if (not m_event_actions[events_action::about_to_exit_app] && not m_coin_info->get_ticker().isEmpty())
+        {
+            this->m_actions_queue.push(action::refresh_current_ticker);
+        }
+        refresh_fiat_balance_all(get_paprika());
+    }
+
     void
     application::on_ticker_balance_updated_event(const ticker_balance_updated& evt) noexcept
     {
@@ -1116,7 +1204,10 @@ namespace atomic_dex
     bool
     application::login(const QString& password, const QString& wallet_name)
     {
-        bool res = m_wallet_manager.login(password, wallet_name, get_mm2(), [this, &wallet_name]() {
+        //! The session ends when the portfolio is complete, see on_coin_fully_initialized_event
+        get_startup_tracer().begin_session();
+        startup_span span("login");
+        bool         res = m_wallet_manager.login(password, wallet_name, get_mm2(), [this, &wallet_name]() {
             this->set_wallet_default_name(wallet_name);
             this->set_status("initializing_mm2");
         });
@@ -1173,12 +1264,12 @@ namespace atomic_dex
 
         {
             auto coins = mm2.get_enabled_coins();
-            refresh_coin(coins, m_enabled_coins);
+            refresh_coin(*coins, m_enabled_coins);
             emit enabledCoinsChanged();
         }
         {
             auto coins = mm2.get_enableable_coins();
-            refresh_coin(coins, m_enableable_coins);
+            refresh_coin(*coins, m_enableable_coins);
             emit enableableCoinsChanged();
         }
         {
@@ -1189,6 +1280,28 @@ namespace atomic_dex
         }
     }
 
+    void
+    application::process_coins_disabled_action()
+    {
+        std::vector<std::string> tickers;
+        std::swap(tickers, *m_disabled_tickers.synchronize());
+
+        QStringList coins;
+        coins.reserve(tickers.size());
+        for (auto&& ticker: tickers) { coins.push_back(QString::fromStdString(ticker)); }
+        system_manager_.get_system<portfolio_page>().get_portfolio()->disable_coins(coins);
+
+        auto& trading = system_manager_.get_system<trading_page>();
+        for (auto&& coin: coins)
+        {
+            trading.disable_coin(coin);
+            if (m_coin_info->get_ticker() == coin && m_kmd_fully_enabled)
+            {
+                m_coin_info->set_ticker("KMD");
+            }
+        }
+    }
+
     void
     application::process_refresh_current_ticker_infos()
     {
@@ -1197,6 +1310,7 @@ namespace atomic_dex
 
         refresh_transactions(mm2);
         refresh_fiat_balance(mm2, paprika);
+        refresh_fiat_balance_all(paprika);
         refresh_address(mm2);
         {
             const auto  ticker = m_coin_info->get_ticker().toStdString();
@@ -1213,7 +1327,38 @@ namespace atomic_dex
             spdlog::trace("price to be set: {}", price.toStdString());
             m_coin_info->set_price(price);
             m_coin_info->set_change24h(retrieve_change_24h(paprika, info, config));
-            m_coin_info->set_trend_7d(nlohmann_json_array_to_qt_json_array(paprika.get_ticker_historical(ticker).answer));
+            m_coin_info->set_trend_7d(price_series_to_qt_json_array(paprika.get_ticker_historical(ticker)));
+        }
+    }
+
+    void
+    application::process_refresh_rates_action()
+    {
+        rates_updated changes;
+        std::swap(changes, *m_rates_to_refresh.synchronize());
+
+        const auto& config = system_manager_.get_system<settings_page>().get_cfg();
+        if (std::find(begin(changes.currencies), end(changes.currencies), config.current_currency) == end(changes.currencies))
+        {
+            //! None of the displayed values changed
+            return;
+        }
+
+        //! Several events may have been merged before this action was processed
+        std::sort(begin(changes.tickers), end(changes.tickers));
+        changes.tickers.erase(std::unique(begin(changes.tickers), end(changes.tickers)), end(changes.tickers));
+
+        auto& paprika = get_paprika();
+        refresh_fiat_balance_all(paprika);
+        system_manager_.get_system<portfolio_page>().get_portfolio()->update_rates_values(changes.tickers);
+
+        const auto ticker = m_coin_info->get_ticker().toStdString();
+        if (not ticker.empty() && std::binary_search(begin(changes.tickers), end(changes.tickers), ticker))
+        {
+            refresh_fiat_balance(get_mm2(), paprika);
+            std::error_code ec;
+            m_coin_info->set_price(QString::fromStdString(paprika.get_rate_conversion(config.current_currency, ticker, ec, true)));
+            m_coin_info->set_change24h(retrieve_change_24h(paprika, get_mm2().get_coin_info(ticker), config));
         }
     }
 
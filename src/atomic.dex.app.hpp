@@ -74,15 +74,19 @@ namespace atomic_dex
         Q_PROPERTY(QString wallet_default_name READ get_wallet_default_name WRITE set_wallet_default_name NOTIFY onWalletDefaultNameChanged)
         Q_PROPERTY(QString balance_fiat_all READ get_balance_fiat_all WRITE set_current_balance_fiat_all NOTIFY onFiatBalanceAllChanged)
         Q_PROPERTY(QString initial_loading_status READ get_status WRITE set_status NOTIFY onStatusChanged)
+        Q_PROPERTY(QVariantMap activation_progress READ get_activation_progress NOTIFY activationProgressChanged)
 
         //! Private function
         void refresh_transactions(const atomic_dex::mm2& mm2_system);
         void refresh_fiat_balance(const atomic_dex::mm2& mm2_system, const coinpaprika_provider& coinpaprika_system);
+        void refresh_fiat_balance_all(const coinpaprika_provider& coinpaprika_system);
         void refresh_address(atomic_dex::mm2& mm2_system);
         void connect_signals();
         void tick();
         void process_refresh_enabled_coin_action();
         void process_refresh_current_ticker_infos();
+        void process_refresh_rates_action();
+        void process_coins_disabled_action();
 
         enum events_action
         {
@@ -96,6 +100,9 @@ namespace atomic_dex
         //! Private typedefs
         using t_actions_queue          = boost::lockfree::queue<action>;
         using t_synchronized_string    = boost::synchronized_value<std::string>;
+        using t_synchronized_rates     = boost::synchronized_value<rates_updated>;
+        using t_synchronized_tickers   = boost::synchronized_value<std::vector<std::string>>;
+        using t_synchronized_progress  = boost::synchronized_value<coins_activation_progress>;
         using t_manager_model_registry = std::unordered_map<std::string, QObject*>;
         using t_events_actions         = std::array<std::atomic_bool, events_action::size>;
 
@@ -104,6 +111,8 @@ namespace atomic_dex
         atomic_dex::qt_wallet_manager m_wallet_manager;
         t_actions_queue               m_actions_queue{g_max_actions_size};
         t_synchronized_string         m_ticker_balance_to_refresh;
+        t_synchronized_rates          m_rates_to_refresh; ///< merged changes not yet applied to the models
+        t_synchronized_tickers        m_disabled_tickers; ///< coins confirmed as disabled by mm2, not yet removed from the models
         QVariantList                  m_enabled_coins;
         QVariantList                  m_enableable_coins;
         QVariant                      m_update_status;
@@ -114,6 +123,7 @@ namespace atomic_dex
         t_events_actions              m_event_actions{{false}};
         std::atomic_bool              m_btc_fully_enabled{false};
         std::atomic_bool              m_kmd_fully_enabled{false};
+        t_synchronized_progress       m_activation_progress; ///< enabled and total are always read as a pair
 
       public:
         //! Constructor
@@ -127,12 +137,15 @@ namespace atomic_dex
         void on_coin_fully_initialized_event(const coin_fully_initialized&) noexcept;
         void on_change_ticker_event(const change_ticker_event&) noexcept;
         void on_tx_fetch_finished_event(const tx_fetch_finished&) noexcept;
-        void on_coin_disabled_event(const coin_disabled&) noexcept;
+        void on_coins_disabled_event(const coins_disabled&) noexcept;
         void on_mm2_initialized_event(const mm2_initialized&) noexcept;
         void on_mm2_started_event(const mm2_started&) noexcept;
         void on_refresh_update_status_event(const refresh_update_status&) noexcept;
         void on_process_orders_finished_event(const process_orders_finished&) noexcept;
         void on_process_swaps_finished_event(const process_swaps_finished&) noexcept;
+        void on_rates_updated_event(const rates_updated&) noexcept;
+        void on_coins_activation_progress_event(const coins_activation_progress&) noexcept;
+        void on_update_portfolio_values_event(const update_portfolio_values&) noexcept;
 
         //! Properties Getter
         // static const QString&      get_empty_string();
@@ -153,6 +166,7 @@ namespace atomic_dex
         QString                    get_balance_fiat_all() const noexcept;
         QString                    get_wallet_default_name() const noexcept;
         QString                    get_status() const noexcept;
+        QVariantMap                get_activation_progress() const noexcept;
         QVariant                   get_update_status() const noexcept;
         Q_INVOKABLE static QString get_version() noexcept;
 
@@ -228,6 +242,7 @@ namespace atomic_dex
         void coinInfoChanged();
         void onFiatBalanceAllChanged();
         void onStatusChanged();
+        void activationProgressChanged();
         void onWalletDefaultNameChanged();
         void myOrdersUpdated();
         void addressbookChanged();
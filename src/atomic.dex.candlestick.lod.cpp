@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+//! Project Headers
+#include "atomic.dex.candlestick.lod.hpp"
+
+namespace atomic_dex
+{
+    candlestick_data
+    merge_candles(const candlestick_data& left, const candlestick_data& right) noexcept
+    {
+        return {
+            .timestamp = left.timestamp,
+            .open      = left.open,
+            .high      = std::max(left.high, right.high),
+            .low       = std::min(left.low, right.low),
+            .close     = right.close,
+            .volume    = left.volume + right.volume,
+            .ma_20     = right.ma_20,
+            .ma_50     = right.ma_50};
+    }
+
+    std::vector<t_candlesticks>
+    build_candlestick_lod_levels(t_candlesticks&& candles, std::size_t min_lod_size)
+    {
+        std::vector<t_candlesticks> levels;
+        if (candles.empty())
+        {
+            return levels;
+        }
+
+        levels.emplace_back(std::move(candles));
+        while (levels.back().size() > min_lod_size)
+        {
+            const auto&    precedent = levels.back();
+            t_candlesticks next_level;
+            next_level.reserve(precedent.size() / 2 + 1);
+            for (std::size_t idx = 0; idx + 1 < precedent.size(); idx += 2) { next_level.emplace_back(merge_candles(precedent[idx], precedent[idx + 1])); }
+            if (precedent.size() % 2 != 0)
+            {
+                next_level.emplace_back(precedent.back());
+            }
+            levels.emplace_back(std::move(next_level));
+        }
+        return levels;
+    }
+
+    std::size_t
+    select_candlestick_lod(std::size_t nb_visible_candles, int visible_width, int min_candle_width, std::size_t nb_levels, std::size_t current_lod) noexcept
+    {
+        if (visible_width <= 0 || nb_levels == 0)
+        {
+            return 0;
+        }
+
+        const std::size_t max_visible_candles = std::max(1, visible_width / std::max(1, min_candle_width));
+        std::size_t       wanted_lod          = 0;
+        while (wanted_lod + 1 < nb_levels && (nb_visible_candles >> wanted_lod) > max_visible_candles) { ++wanted_lod; }
+
+        if (wanted_lod < current_lod && (nb_visible_candles >> wanted_lod) * 4 > max_visible_candles * 3)
+        {
+            return wanted_lod + 1;
+        }
+        return wanted_lod;
+    }
+} // namespace atomic_dex
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#pragma once
+
+//! PCH
+#include "atomic.dex.pch.hpp"
+
+namespace atomic_dex
+{
+    struct candlestick_data
+    {
+        std::uint64_t timestamp;
+        double        open;
+        double        high;
+        double        low;
+        double        close;
+        double        volume;
+        double        ma_20;
+        double        ma_50;
+    };
+
+    using t_candlesticks = std::vector<candlestick_data>;
+
+    //! One candle covering both: first open, highest high, lowest low, last close, summed volume
+    candlestick_data merge_candles(const candlestick_data& left, const candlestick_data& right) noexcept;
+
+    //! levels[0] is the full series, each next level merges two candles of the precedent one until it has at most min_lod_size candles
+    std::vector<t_candlesticks> build_candlestick_lod_levels(t_candlesticks&& candles, std::size_t min_lod_size);
+
+    //! Finest level whose visible candles are at least min_candle_width pixels wide
+    //! Going back to a finer level needs a 25% margin so a pan around the threshold doesn't flip the level on every move
+    std::size_t
+    select_candlestick_lod(std::size_t nb_visible_candles, int visible_width, int min_candle_width, std::size_t nb_levels, std::size_t current_lod) noexcept;
+} // namespace atomic_dex
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#include "atomic.dex.candlestick.lod.hpp"
+#include <doctest/doctest.h>
+
+namespace
+{
+    atomic_dex::candlestick_data
+    make_candle(std::uint64_t timestamp, double open, double high, double low, double close, double volume)
+    {
+        return {.timestamp = timestamp, .open = open, .high = high, .low = low, .close = close, .volume = volume, .ma_20 = open, .ma_50 = open};
+    }
+} // namespace
+
+TEST_CASE("atomic dex candlestick merge")
+{
+    const auto merged = atomic_dex::merge_candles(make_candle(60, 2.0, 5.0, 1.5, 3.0, 10.0), make_candle(120, 3.0, 4.0, 1.0, 2.5, 5.0));
+    CHECK_EQ(merged.timestamp, 60);
+    CHECK_EQ(merged.open, doctest::Approx(2.0));
+    CHECK_EQ(merged.high, doctest::Approx(5.0));
+    CHECK_EQ(merged.low, doctest::Approx(1.0));
+    CHECK_EQ(merged.close, doctest::Approx(2.5));
+    CHECK_EQ(merged.volume, doctest::Approx(15.0));
+}
+
+TEST_CASE("atomic dex candlestick level of detail")
+{
+    atomic_dex::t_candlesticks candles;
+    for (std::uint64_t idx = 0; idx < 5; ++idx)
+    {
+        const auto price = static_cast<double>(idx + 1);
+        candles.push_back(make_candle(idx * 60, price, price + 0.5, price - 0.5, price + 0.25, 1.0));
+    }
+
+    SUBCASE("each level merges two candles of the precedent one and keeps an odd last candle")
+    {
+        const auto levels = atomic_dex::build_candlestick_lod_levels(std::move(candles), 1);
+        REQUIRE_EQ(levels.size(), 4);
+        CHECK_EQ(levels[0].size(), 5);
+        CHECK_EQ(levels[1].size(), 3);
+        CHECK_EQ(levels[2].size(), 2);
+        CHECK_EQ(levels[3].size(), 1);
+
+        const auto& whole = levels[3][0];
+        CHECK_EQ(whole.timestamp, 0);
+        CHECK_EQ(whole.open, doctest::Approx(1.0));
+        CHECK_EQ(whole.high, doctest::Approx(5.5));
+        CHECK_EQ(whole.low, doctest::Approx(0.5));
+        CHECK_EQ(whole.close, doctest::Approx(5.25));
+        CHECK_EQ(whole.volume, doctest::Approx(5.0));
+        CHECK_EQ(levels[1][2].timestamp, 240);
+    }
+
+    SUBCASE("a series already small enough has a single level")
+    {
+        CHECK_EQ(atomic_dex::build_candlestick_lod_levels(std::move(candles), 64).size(), 1);
+        CHECK(atomic_dex::build_candlestick_lod_levels({}, 64).empty());
+    }
+}
+
+TEST_CASE("atomic dex candlestick level selection")
+{
+    using atomic_dex::select_candlestick_lod;
+
+    //! 300 pixels with 3 pixels per candle, 100 candles fit
+    CHECK_EQ(select_candlestick_lod(100, 300, 3, 4, 0), 0);
+    CHECK_EQ(select_candlestick_lod(101, 300, 3, 4, 0), 1);
+    CHECK_EQ(select_candlestick_lod(400, 300, 3, 4, 0), 2);
+    CHECK_EQ(select_candlestick_lod(10000, 300, 3, 4, 0), 3);
+
+    //! Unknown width or no data keeps the full series
+    CHECK_EQ(select_candlestick_lod(10000, 0, 3, 4, 2), 0);
+    CHECK_EQ(select_candlestick_lod(10000, 300, 3, 0, 0), 0);
+
+    //! Zooming back in only goes finer once the finer level fits with a margin
+    CHECK_EQ(select_candlestick_lod(100, 300, 3, 4, 1), 1);
+    CHECK_EQ(select_candlestick_lod(76, 300, 3, 4, 1), 1);
+    CHECK_EQ(select_candlestick_lod(75, 300, 3, 4, 1), 0);
+}
@@ -0,0 +1,315 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+//! Project Headers
+#include "atomic.dex.electrum.health.hpp"
+
+namespace
+{
+    namespace asio = boost::asio;
+    using asio::ip::tcp;
+    using t_probe_clock = std::chrono::steady_clock;
+
+    constexpr std::uint32_t    g_electrum_max_failures      = 3;
+    constexpr double           g_electrum_latency_smoothing = 0.3;
+    constexpr std::string_view g_server_version_request     = "{\"jsonrpc\":\"2.0\",\"method\":\"server.version\",\"params\":[\"atomicDEX\",\"1.4\"],\"id\":0}\n";
+
+    struct probe_state
+    {
+        tcp::resolver             resolver;
+        tcp::socket               socket;
+        asio::streambuf           answer;
+        t_probe_clock::time_point start;
+        std::optional<double>     latency_ms;
+
+        explicit probe_state(asio::io_context& io_context) : resolver(io_context), socket(io_context) {}
+    };
+
+    //! Every probe runs on the same io_context, the whole batch takes at most timeout, std::nullopt for the failed probes
+    std::vector<std::optional<double>>
+    measure_latencies(const std::vector<atomic_dex::electrum_server>& servers, std::chrono::milliseconds timeout)
+    {
+        asio::io_context                          io_context;
+        std::vector<std::unique_ptr<probe_state>> probes;
+        probes.reserve(servers.size());
+        for (auto&& server: servers)
+        {
+            auto&      state     = *probes.emplace_back(std::make_unique<probe_state>(io_context));
+            const auto separator = server.url.rfind(':');
+            if (separator == std::string::npos)
+            {
+                spdlog::warn("invalid electrum url: {}", server.url);
+                continue;
+            }
+
+            const auto on_answer = [&state](const boost::system::error_code& ec, std::size_t) {
+                if (not ec)
+                {
+                    state.latency_ms = std::chrono::duration<double, std::milli>(t_probe_clock::now() - state.start).count();
+                }
+            };
+            const auto on_connect = [&state, on_answer](const boost::system::error_code& ec, const tcp::endpoint&) {
+                if (ec)
+                {
+                    return;
+                }
+                const auto request = asio::buffer(g_server_version_request.data(), g_server_version_request.size());
+                asio::async_write(state.socket, request, [&state, on_answer](const boost::system::error_code& ec, std::size_t) {
+                    if (not ec)
+                    {
+                        asio::async_read_until(state.socket, state.answer, '\n', on_answer);
+                    }
+                });
+            };
+            state.resolver.async_resolve(
+                server.url.substr(0, separator), server.url.substr(separator + 1),
+                [&state, on_connect](const boost::system::error_code& ec, const tcp::resolver::results_type& endpoints) {
+                    if (not ec)
+                    {
+                        //! Resolutions are queued on the shared io_context, only the connection and the answer are measured
+                        state.start = t_probe_clock::now();
+                        asio::async_connect(state.socket, endpoints, on_connect);
+                    }
+                });
+        }
+
+        io_context.run_for(timeout);
+
+        std::vector<std::optional<double>> out;
+        out.reserve(probes.size());
+        for (auto&& state: probes) { out.push_back(state->latency_ms); }
+        return out;
+    }
+} // namespace
+
+//! Json Serialization / Deserialization functions
+namespace atomic_dex
+{
+    void
+    to_json(nlohmann::json& j, const electrum_server_score& score)
+    {
+        j["latency_ms"]  = std::isnan(score.latency_ms) ? nlohmann::json(nullptr) : nlohmann::json(score.latency_ms);
+        j["nb_failures"] = score.nb_failures;
+        j["last_probe"]  = score.last_probe;
+    }
+
+    void
+    from_json(const nlohmann::json& j, electrum_server_score& score)
+    {
+        score.latency_ms = j.at("latency_ms").is_number() ? j.at("latency_ms").get<double>() : std::numeric_limits<double>::quiet_NaN();
+        j.at("nb_failures").get_to(score.nb_failures);
+        j.at("last_probe").get_to(score.last_probe);
+    }
+} // namespace atomic_dex
+
+namespace atomic_dex
+{
+    electrum_health_monitor::electrum_health_monitor(fs::path scores_path, std::chrono::milliseconds probe_timeout) :
+        m_scores_path(std::move(scores_path)), m_probe_timeout(probe_timeout)
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        load_scores();
+    }
+
+    electrum_health_monitor::~electrum_health_monitor() noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        stop();
+    }
+
+    void
+    electrum_health_monitor::load_scores() noexcept
+    {
+        std::ifstream ifs(m_scores_path.string());
+        if (not ifs.is_open())
+        {
+            return;
+        }
+
+        try
+        {
+            nlohmann::json j;
+            ifs >> j;
+            std::scoped_lock lock(m_scores_mutex);
+            m_scores = j.get<t_scores>();
+        }
+        catch (const std::exception& error)
+        {
+            spdlog::warn("cannot parse electrum scores {}: {}", m_scores_path.string(), error.what());
+        }
+    }
+
+    void
+    electrum_health_monitor::save_scores() const noexcept
+    {
+        const fs::path tmp_path = fs::path(m_scores_path).replace_extension(".tmp");
+        {
+            std::ofstream ofs(tmp_path.string(), std::ios::trunc);
+            if (not ofs.is_open())
+            {
+                spdlog::warn("cannot write electrum scores: {}", tmp_path.string());
+                return;
+            }
+            ofs << nlohmann::json(m_scores);
+        }
+
+        boost::system::error_code ec;
+        fs::rename(tmp_path, m_scores_path, ec);
+        if (ec)
+        {
+            spdlog::warn("error: {}", ec.message());
+            fs::remove(tmp_path, ec);
+        }
+    }
+
+    void
+    electrum_health_monitor::probe(const std::vector<electrum_server>& servers) noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        const auto latencies = measure_latencies(servers, m_probe_timeout);
+        const auto now       = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+        std::scoped_lock lock(m_scores_mutex);
+        for (std::size_t idx = 0; idx < servers.size(); ++idx)
+        {
+            auto& score      = m_scores[servers[idx].url];
+            score.last_probe = now;
+            if (not latencies[idx].has_value())
+            {
+                ++score.nb_failures;
+                spdlog::info("electrum server {} failed {} probe(s) in a row", servers[idx].url, score.nb_failures);
+                continue;
+            }
+
+            score.nb_failures = 0;
+            score.latency_ms  = std::isnan(score.latency_ms)
+                                   ? latencies[idx].value()
+                                   : g_electrum_latency_smoothing * latencies[idx].value() + (1.0 - g_electrum_latency_smoothing) * score.latency_ms;
+        }
+        save_scores();
+    }
+
+    void
+    electrum_health_monitor::start(t_servers_provider servers_provider, std::chrono::seconds interval)
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        if (m_probe_thread.joinable())
+        {
+            return;
+        }
+
+        m_probe_thread = std::thread([this, servers_provider = std::move(servers_provider), interval]() {
+            std::unique_lock lock(m_probe_mutex);
+            while (not m_stopping)
+            {
+                lock.unlock();
+                auto servers = servers_provider();
+
+                //! The same server is often shared by several coins
+                std::sort(servers.begin(), servers.end(), [](const auto& lhs, const auto& rhs) { return lhs.url < rhs.url; });
+                servers.erase(
+                    std::unique(servers.begin(), servers.end(), [](const auto& lhs, const auto& rhs) { return lhs.url == rhs.url; }), servers.end());
+                probe(servers);
+
+                lock.lock();
+                m_probe_cv.wait_for(lock, interval, [this]() { return m_stopping; });
+            }
+        });
+    }
+
+    void
+    electrum_health_monitor::stop() noexcept
+    {
+        {
+            std::scoped_lock lock(m_probe_mutex);
+            m_stopping = true;
+        }
+        m_probe_cv.notify_all();
+        if (m_probe_thread.joinable())
+        {
+            m_probe_thread.join();
+        }
+    }
+
+    std::vector<electrum_server>
+    electrum_health_monitor::rank(std::vector<electrum_server> servers) const noexcept
+    {
+        //! 0: healthy, 1: never succeeded, 2: failed recently, 3: dead
+        std::vector<std::pair<int, double>> keys;
+        keys.reserve(servers.size());
+        {
+            std::scoped_lock lock(m_scores_mutex);
+            for (auto&& server: servers)
+            {
+                const auto it = m_scores.find(server.url);
+                if (it == m_scores.end())
+                {
+                    keys.emplace_back(1, 0.0);
+                }
+                else if (it->second.nb_failures >= g_electrum_max_failures)
+                {
+                    keys.emplace_back(3, 0.0);
+                }
+                else if (it->second.nb_failures > 0)
+                {
+                    keys.emplace_back(2, 0.0);
+                }
+                else if (std::isnan(it->second.latency_ms))
+                {
+                    keys.emplace_back(1, 0.0);
+                }
+                else
+                {
+                    keys.emplace_back(0, it->second.latency_ms);
+                }
+            }
+        }
+
+        std::vector<std::size_t> order(servers.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&keys](std::size_t lhs, std::size_t rhs) { return keys[lhs] < keys[rhs]; });
+
+        std::vector<electrum_server> out;
+        out.reserve(servers.size());
+        for (auto&& idx: order)
+        {
+            if (keys[idx].first == 3 && not out.empty())
+            {
+                continue;
+            }
+            out.push_back(std::move(servers[idx]));
+        }
+        return out;
+    }
+
+    std::optional<electrum_server_score>
+    electrum_health_monitor::get_score(const std::string& url) const noexcept
+    {
+        std::scoped_lock lock(m_scores_mutex);
+        if (const auto it = m_scores.find(url); it != m_scores.end())
+        {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+} // namespace atomic_dex
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include "atomic.dex.pch.hpp"
+
+//! Project Headers
+#include "atomic.dex.coins.config.hpp"
+
+namespace atomic_dex
+{
+    struct electrum_server_score
+    {
+        double        latency_ms{std::numeric_limits<double>::quiet_NaN()}; ///< moving average of the successful probes, NaN if none succeeded yet
+        std::uint32_t nb_failures{0};                                       ///< consecutive failed probes
+        std::int64_t  last_probe{0};                                        ///< unix timestamp
+    };
+
+    void to_json(nlohmann::json& j, const electrum_server_score& score);
+    void from_json(const nlohmann::json& j, electrum_server_score& score);
+
+    //! Health of the electrum servers measured in background (connection + server.version round trip), persisted between sessions
+    //! The servers given to mm2 at enable time are ordered by latency and the dead ones are dropped
+    class electrum_health_monitor
+    {
+      public:
+        using t_servers_provider = std::function<std::vector<electrum_server>()>;
+
+      private:
+        using t_scores = std::unordered_map<std::string, electrum_server_score>;
+
+        fs::path                  m_scores_path;
+        std::chrono::milliseconds m_probe_timeout;
+        mutable std::mutex        m_scores_mutex;
+        t_scores                  m_scores;
+        std::mutex                m_probe_mutex;
+        std::condition_variable   m_probe_cv;
+        bool                      m_stopping{false};
+        std::thread               m_probe_thread;
+
+        //! Private API
+        void load_scores() noexcept;
+        void save_scores() const noexcept; ///< m_scores_mutex must be held
+
+      public:
+        //! Constructor, load the scores of the previous sessions
+        explicit electrum_health_monitor(fs::path scores_path, std::chrono::milliseconds probe_timeout = std::chrono::seconds(3));
+
+        //! Destructor, stop the probe thread
+        ~electrum_health_monitor() noexcept;
+
+        //! Probe every server concurrently, block at most probe_timeout
+        void probe(const std::vector<electrum_server>& servers) noexcept;
+
+        //! Probe the servers returned by servers_provider now and then every interval until stop
+        void start(t_servers_provider servers_provider, std::chrono::seconds interval);
+        void stop() noexcept;
+
+        //! Fastest servers first, the never probed ones after them in config order, the failing ones last
+        //! A server that failed too many times in a row is dropped as long as another one is healthy
+        [[nodiscard]] std::vector<electrum_server> rank(std::vector<electrum_server> servers) const noexcept;
+
+        [[nodiscard]] std::optional<electrum_server_score> get_score(const std::string& url) const noexcept;
+    };
+} // namespace atomic_dex
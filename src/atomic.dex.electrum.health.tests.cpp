@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.electrum.health.hpp"
+#include "atomic.dex.electrum.stub.server.hpp"
+#include <doctest/doctest.h>
+
+namespace
+{
+    //! Url of a local port nobody listens on
+    std::string
+    get_dead_url()
+    {
+        boost::asio::io_context        io_context;
+        boost::asio::ip::tcp::acceptor acceptor(io_context, {boost::asio::ip::make_address("127.0.0.1"), 0});
+        const auto                     port = acceptor.local_endpoint().port();
+        acceptor.close();
+        return "127.0.0.1:" + std::to_string(port);
+    }
+} // namespace
+
+SCENARIO("atomic dex electrum health monitor")
+{
+    using namespace std::chrono_literals;
+
+    GIVEN("A fast server, a slow server and a dead one")
+    {
+        const fs::path scores_path = fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.json");
+
+        atomic_dex::electrum_stub_server fast;
+        atomic_dex::electrum_stub_server slow(150ms);
+        fast.start();
+        slow.start();
+
+        const std::vector<atomic_dex::electrum_server> servers{{.url = get_dead_url()}, {.url = slow.get_url()}, {.url = fast.get_url()}};
+
+        WHEN("the servers are probed")
+        {
+            {
+                atomic_dex::electrum_health_monitor monitor(scores_path, 1s);
+                for (std::size_t idx = 0; idx < 3; ++idx) { monitor.probe(servers); }
+
+                THEN("the fastest server comes first and the dead one is dropped")
+                {
+                    CHECK_EQ(fast.get_nb_requests(), 3);
+                    CHECK_EQ(slow.get_nb_requests(), 3);
+                    CHECK_EQ(monitor.get_score(servers[0].url)->nb_failures, 3);
+                    CHECK_LT(monitor.get_score(fast.get_url())->latency_ms, monitor.get_score(slow.get_url())->latency_ms);
+
+                    const auto ranked = monitor.rank(servers);
+                    REQUIRE_EQ(ranked.size(), 2);
+                    CHECK_EQ(ranked[0].url, fast.get_url());
+                    CHECK_EQ(ranked[1].url, slow.get_url());
+                }
+
+                AND_THEN("a never probed server is kept after the healthy ones")
+                {
+                    const auto ranked = monitor.rank({{.url = "127.0.0.1:1"}, {.url = slow.get_url()}});
+                    REQUIRE_EQ(ranked.size(), 2);
+                    CHECK_EQ(ranked[0].url, slow.get_url());
+                }
+
+                AND_THEN("the dead server is kept when nothing else is left")
+                {
+                    CHECK_EQ(monitor.rank({servers[0]}).size(), 1);
+                }
+            }
+
+            AND_WHEN("the scores are reloaded")
+            {
+                atomic_dex::electrum_health_monitor reloaded(scores_path);
+                REQUIRE(reloaded.get_score(fast.get_url()).has_value());
+                CHECK_EQ(reloaded.rank(servers).front().url, fast.get_url());
+            }
+        }
+
+        fast.stop();
+        slow.stop();
+        fs::remove(scores_path);
+    }
+}
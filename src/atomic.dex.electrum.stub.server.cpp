@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+//! Project Headers
+#include "atomic.dex.electrum.stub.server.hpp"
+
+namespace
+{
+    namespace asio = boost::asio;
+    using asio::ip::tcp;
+
+    constexpr const char* g_server_version_answer = R"({"jsonrpc":"2.0","result":["ElectrumX 1.14.0","1.4"],"id":0})"
+                                                    "\n";
+} // namespace
+
+namespace atomic_dex
+{
+    electrum_stub_server::electrum_stub_server(std::chrono::milliseconds latency) :
+        m_acceptor(m_io_context, tcp::endpoint(asio::ip::make_address("127.0.0.1"), 0)), m_latency(latency)
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+    }
+
+    electrum_stub_server::~electrum_stub_server() noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        stop();
+    }
+
+    void
+    electrum_stub_server::serve_one(tcp::socket& socket)
+    {
+        //! Electrum requests are json lines, the connection stays open until the client closes it
+        asio::streambuf           buffer;
+        boost::system::error_code ec;
+        while (m_running && asio::read_until(socket, buffer, '\n', ec) > 0 && not ec)
+        {
+            buffer.consume(buffer.size());
+            ++m_nb_requests;
+            if (m_latency.count() > 0)
+            {
+                std::this_thread::sleep_for(m_latency);
+            }
+            asio::write(socket, asio::buffer(std::string(g_server_version_answer)), ec);
+        }
+        socket.shutdown(tcp::socket::shutdown_both, ec);
+    }
+
+    void
+    electrum_stub_server::start()
+    {
+        if (m_running.exchange(true))
+        {
+            return;
+        }
+
+        m_server_thread = std::thread([this]() {
+            while (m_running)
+            {
+                tcp::socket               socket(m_io_context);
+                boost::system::error_code ec;
+                m_acceptor.accept(socket, ec);
+                if (ec || not m_running)
+                {
+                    continue;
+                }
+                serve_one(socket);
+            }
+        });
+    }
+
+    void
+    electrum_stub_server::stop() noexcept
+    {
+        if (not m_running.exchange(false))
+        {
+            return;
+        }
+
+        //! Wake up the blocking accept
+        boost::system::error_code ec;
+        tcp::socket               wake_up(m_io_context);
+        wake_up.connect(m_acceptor.local_endpoint(ec), ec);
+        if (m_server_thread.joinable())
+        {
+            m_server_thread.join();
+        }
+        m_acceptor.close(ec);
+    }
+
+    std::string
+    electrum_stub_server::get_url() const
+    {
+        return "127.0.0.1:" + std::to_string(m_acceptor.local_endpoint().port());
+    }
+
+    std::size_t
+    electrum_stub_server::get_nb_requests() const noexcept
+    {
+        return m_nb_requests.load();
+    }
+} // namespace atomic_dex
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include "atomic.dex.pch.hpp"
+
+namespace atomic_dex
+{
+    //! Local stand-in of an electrum server answering server.version, used by the tests of the electrum health monitor
+    class electrum_stub_server
+    {
+        boost::asio::io_context        m_io_context;
+        boost::asio::ip::tcp::acceptor m_acceptor;
+        std::thread                    m_server_thread;
+        std::atomic_bool               m_running{false};
+        std::chrono::milliseconds      m_latency;
+        std::atomic<std::size_t>       m_nb_requests{0};
+
+        //! Private API
+        void serve_one(boost::asio::ip::tcp::socket& socket);
+
+      public:
+        //! Listen on a random local port, latency is added before every answer
+        explicit electrum_stub_server(std::chrono::milliseconds latency = std::chrono::milliseconds(0));
+        ~electrum_stub_server() noexcept;
+
+        void start();
+        void stop() noexcept;
+
+        //! eg: 127.0.0.1:45123, same layout as the urls of the coins config
+        [[nodiscard]] std::string get_url() const;
+
+        [[nodiscard]] std::size_t get_nb_requests() const noexcept;
+    };
+} // namespace atomic_dex
@@ -71,9 +71,24 @@ namespace atomic_dex
         std::string ticker;
     };
 
-    struct coin_disabled
+    //! Event sent while coins are enabled, the totals cover every batch in flight, nb_total only decreases when a coin fails to enable
+    struct coins_activation_progress
     {
-        std::string ticker;
+        std::size_t nb_enabled{0};
+        std::size_t nb_total{0};
+    };
+
+    //! Event sent once per disable request with the tickers mm2 confirmed as disabled
+    struct coins_disabled
+    {
+        std::vector<std::string> tickers;
+    };
+
+    //! Event when paprika publishes new rates, only the tickers and currencies with a different rate are listed
+    struct rates_updated
+    {
+        std::vector<std::string> tickers;
+        std::vector<std::string> currencies;
     };
 
     struct orderbook_refresh
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+//! Project Headers
+#include "atomic.dex.http.endpoints.hpp"
+
+namespace
+{
+    std::string
+    with_trailing_slash(std::string endpoint)
+    {
+        if (endpoint.empty() || endpoint.back() != '/')
+        {
+            endpoint.push_back('/');
+        }
+        return endpoint;
+    }
+
+    void
+    override_from_env(std::string& endpoint, const char* env_name)
+    {
+        if (const char* value = std::getenv(env_name); value != nullptr && *value != '\0')
+        {
+            spdlog::info("{} overridden by {}: {}", endpoint, env_name, value);
+            endpoint = value;
+        }
+    }
+
+    boost::synchronized_value<atomic_dex::external_endpoints>&
+    get_endpoints_storage()
+    {
+        static boost::synchronized_value<atomic_dex::external_endpoints> endpoints = []() {
+            atomic_dex::external_endpoints out;
+            override_from_env(out.coinpaprika, "ATOMIC_DEX_COINPAPRIKA_ENDPOINT");
+            override_from_env(out.cex, "ATOMIC_DEX_CEX_ENDPOINT");
+            override_from_env(out.openrates, "ATOMIC_DEX_OPENRATES_ENDPOINT");
+            out.coinpaprika = with_trailing_slash(std::move(out.coinpaprika));
+            out.cex         = with_trailing_slash(std::move(out.cex));
+            out.openrates   = with_trailing_slash(std::move(out.openrates));
+            return out;
+        }();
+        return endpoints;
+    }
+} // namespace
+
+namespace atomic_dex
+{
+    external_endpoints
+    get_external_endpoints() noexcept
+    {
+        return get_endpoints_storage().get();
+    }
+
+    void
+    set_external_endpoints(external_endpoints endpoints) noexcept
+    {
+        endpoints.coinpaprika = with_trailing_slash(std::move(endpoints.coinpaprika));
+        endpoints.cex         = with_trailing_slash(std::move(endpoints.cex));
+        endpoints.openrates   = with_trailing_slash(std::move(endpoints.openrates));
+        get_endpoints_storage() = std::move(endpoints);
+    }
+} // namespace atomic_dex
@@ -0,0 +1,36 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include "atomic.dex.pch.hpp"
+
+namespace atomic_dex
+{
+    //! Base urls of the external price providers, they always end with a '/'
+    struct external_endpoints
+    {
+        std::string coinpaprika{"https://api.coinpaprika.com/v1/"};
+        std::string cex{"https://komodo.live:3333/"};
+        std::string openrates{"https://api.openrates.io/"};
+    };
+
+    //! Defaults overridden by the ATOMIC_DEX_COINPAPRIKA_ENDPOINT, ATOMIC_DEX_CEX_ENDPOINT and ATOMIC_DEX_OPENRATES_ENDPOINT environment variables
+    external_endpoints get_external_endpoints() noexcept;
+
+    //! Redirect the providers at runtime, eg: to a local replay server
+    void set_external_endpoints(external_endpoints endpoints) noexcept;
+} // namespace atomic_dex
@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+//! Project Headers
+#include "atomic.dex.http.rate.limiter.hpp"
+#include "atomic.dex.http.code.hpp"
+
+namespace atomic_dex
+{
+    http_rate_limiter::http_rate_limiter()
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        set_host_limits("api.coinpaprika.com", {.requests_per_second = 5.0, .burst = 10.0});
+        set_host_limits("komodo.live:3333", {.requests_per_second = 5.0, .burst = 10.0});
+        set_host_limits("komodo.live:3334", {.requests_per_second = 5.0, .burst = 10.0});
+        set_host_limits("api.openrates.io", {.requests_per_second = 1.0, .burst = 2.0});
+    }
+
+    std::string
+    http_rate_limiter::extract_host(const std::string& url)
+    {
+        std::string::size_type start = url.find("://");
+        start                        = start == std::string::npos ? 0 : start + 3;
+        const auto end               = url.find_first_of("/?", start);
+        return url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    }
+
+    http_rate_limiter::bucket&
+    http_rate_limiter::get_bucket(const std::string& host)
+    {
+        auto it = m_buckets.find(host);
+        if (it == m_buckets.end())
+        {
+            const auto now = t_clock::now();
+            it             = m_buckets.emplace(host, bucket{.limits = m_default_limits, .tokens = m_default_limits.burst, .last_refill = now, .blocked_until = now})
+                     .first;
+        }
+        return it->second;
+    }
+
+    void
+    http_rate_limiter::set_host_limits(const std::string& host, http_host_limits limits)
+    {
+        std::scoped_lock lock(m_buckets_mutex);
+        auto&            cur_bucket = get_bucket(host);
+        cur_bucket.tokens           = std::min(cur_bucket.tokens, limits.burst);
+        cur_bucket.limits           = limits;
+    }
+
+    void
+    http_rate_limiter::set_max_blocked_threads(std::size_t max_blocked)
+    {
+        std::scoped_lock lock(m_buckets_mutex);
+        m_max_blocked = max_blocked;
+    }
+
+    bool
+    http_rate_limiter::acquire(const std::string& host, http_request_priority priority)
+    {
+        using namespace std::chrono;
+
+        std::unique_lock lock(m_buckets_mutex);
+        auto&            cur_bucket = get_bucket(host);
+        const auto       prio_idx   = static_cast<std::size_t>(priority);
+        bool             blocked    = false;
+
+        ++cur_bucket.nb_waiting[prio_idx];
+        while (true)
+        {
+            const auto now        = t_clock::now();
+            const auto elapsed    = duration<double>(now - cur_bucket.last_refill).count();
+            cur_bucket.tokens      = std::min(cur_bucket.limits.burst, cur_bucket.tokens + elapsed * cur_bucket.limits.requests_per_second);
+            cur_bucket.last_refill = now;
+
+            const bool higher_priority_waiting =
+                std::any_of(begin(cur_bucket.nb_waiting), begin(cur_bucket.nb_waiting) + prio_idx, [](std::size_t nb) { return nb > 0; });
+            if (now >= cur_bucket.blocked_until && cur_bucket.tokens >= 1.0 && not higher_priority_waiting)
+            {
+                cur_bucket.tokens -= 1.0;
+                --cur_bucket.nb_waiting[prio_idx];
+                m_nb_blocked -= blocked ? 1 : 0;
+                m_buckets_cv.notify_all();
+                return true;
+            }
+
+            //! The pool workers are shared with mm2, only a few of them may sleep here
+            if (not blocked)
+            {
+                if (priority == http_request_priority::low && m_nb_blocked >= m_max_blocked)
+                {
+                    --cur_bucket.nb_waiting[prio_idx];
+                    spdlog::warn("{} threads already wait for the rate limiter, refusing a request to {}", m_nb_blocked, host);
+                    return false;
+                }
+                blocked = true;
+                ++m_nb_blocked;
+            }
+
+            //! Next time a token is available, the requests with a higher priority will wake us up when they are served
+            const auto next_token = now + duration_cast<t_clock::duration>(duration<double>(
+                                              std::max(1.0 - cur_bucket.tokens, 0.0) / cur_bucket.limits.requests_per_second + (higher_priority_waiting ? 0.05 : 0.0)));
+            m_buckets_cv.wait_until(lock, std::max(next_token, cur_bucket.blocked_until));
+        }
+    }
+
+    std::size_t
+    http_rate_limiter::backoff(const std::string& host, std::size_t attempt, std::optional<std::chrono::seconds> retry_after)
+    {
+        using namespace std::chrono;
+        static thread_local std::mt19937 gen(std::random_device{}());
+
+        std::scoped_lock lock(m_buckets_mutex);
+        auto&            cur_bucket = get_bucket(host);
+
+        //! Equal jitter: half of the exponential delay is fixed, the other half is random
+        const auto                             exp_delay = std::min(cur_bucket.limits.max_backoff, cur_bucket.limits.base_backoff * (1ll << std::min<std::size_t>(attempt, 16)));
+        std::uniform_int_distribution<int64_t> distr(0, exp_delay.count() / 2);
+        milliseconds                           delay = exp_delay / 2 + milliseconds(distr(gen));
+        if (retry_after.has_value())
+        {
+            delay = std::max<milliseconds>(delay, retry_after.value());
+        }
+
+        spdlog::warn("{} answered too many requests, pausing it for {} ms (attempt {})", host, delay.count(), attempt + 1);
+        cur_bucket.tokens        = 0;
+        cur_bucket.blocked_until = std::max(cur_bucket.blocked_until, t_clock::now() + delay);
+        m_buckets_cv.notify_all();
+        return cur_bucket.limits.max_retries;
+    }
+
+    RestClient::Response
+    http_rate_limiter::get(const std::string& url, http_request_priority priority)
+    {
+        return send(url, priority, [&url]() { return RestClient::get(url); });
+    }
+
+    RestClient::Response
+    http_rate_limiter::post(const std::string& url, const std::string& content_type, const std::string& data, http_request_priority priority)
+    {
+        return send(url, priority, [&]() { return RestClient::post(url, content_type, data); });
+    }
+
+    RestClient::Response
+    http_rate_limiter::send(const std::string& url, http_request_priority priority, const std::function<RestClient::Response()>& request)
+    {
+        const auto           host = extract_host(url);
+        RestClient::Response resp;
+        for (std::size_t attempt = 0;; ++attempt)
+        {
+            if (not acquire(host, priority))
+            {
+                resp.code = e_http_code::too_many_requests;
+                resp.body = "rate limited locally";
+                return resp;
+            }
+            resp = request();
+            if (resp.code != e_http_code::too_many_requests)
+            {
+                return resp;
+            }
+
+            std::optional<std::chrono::seconds> retry_after;
+            if (auto it = resp.headers.find("Retry-After"); it != resp.headers.end())
+            {
+                try
+                {
+                    retry_after = std::chrono::seconds(std::stoi(it->second));
+                }
+                catch (const std::exception& error)
+                {
+                    spdlog::warn("invalid Retry-After header: {}", error.what());
+                }
+            }
+
+            if (attempt >= backoff(host, attempt, retry_after))
+            {
+                spdlog::error("{} is still rate limited after {} retries, giving up: {}", host, attempt, url);
+                return resp;
+            }
+        }
+    }
+
+    http_rate_limiter&
+    get_http_rate_limiter() noexcept
+    {
+        static http_rate_limiter limiter;
+        return limiter;
+    }
+} // namespace atomic_dex
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include "atomic.dex.pch.hpp"
+
+namespace atomic_dex
+{
+    enum class http_request_priority
+    {
+        high   = 0, ///< prices of the coins currently displayed
+        normal = 1,
+        low    = 2 ///< background refresh, may be refused when too many threads wait, see acquire
+    };
+
+    struct http_host_limits
+    {
+        double                    requests_per_second{5.0};
+        double                    burst{10.0};
+        std::size_t               max_retries{4};
+        std::chrono::milliseconds base_backoff{500};
+        std::chrono::milliseconds max_backoff{30000};
+    };
+
+    //! Token bucket per host shared by every external http provider (coinpaprika, ohlc, tx history, openrates)
+    class http_rate_limiter
+    {
+        using t_clock = std::chrono::steady_clock;
+
+        struct bucket
+        {
+            http_host_limits           limits;
+            double                     tokens;
+            t_clock::time_point        last_refill;
+            t_clock::time_point        blocked_until;
+            std::array<std::size_t, 3> nb_waiting{};
+        };
+
+        std::mutex                              m_buckets_mutex;
+        std::condition_variable                 m_buckets_cv;
+        std::unordered_map<std::string, bucket> m_buckets;
+        http_host_limits                        m_default_limits;
+        std::size_t                             m_nb_blocked{0};
+        std::size_t                             m_max_blocked{4}; ///< half of the threadpool, the other workers keep serving mm2 tasks
+
+        //! Private API
+        bucket&     get_bucket(const std::string& host); ///< m_buckets_mutex must be held
+        std::size_t backoff(const std::string& host, std::size_t attempt, std::optional<std::chrono::seconds> retry_after);
+        RestClient::Response send(const std::string& url, http_request_priority priority, const std::function<RestClient::Response()>& request);
+
+      public:
+        //! Constructor
+        http_rate_limiter();
+
+        //! Limits used for the next requests of this host, eg: api.coinpaprika.com
+        void set_host_limits(const std::string& host, http_host_limits limits);
+
+        //! Maximum number of threads allowed to sleep in acquire, every host included
+        void set_max_blocked_threads(std::size_t max_blocked);
+
+        //! Block until a token of this host is available and no request with a higher priority is waiting for one
+        //! Return false without waiting if max_blocked threads already wait, only the low priority requests (retried by their caller) can be refused
+        bool acquire(const std::string& host, http_request_priority priority);
+
+        //! Rate limited requests, a 429 answer is retried with a jittered exponential backoff until the host retry budget is exhausted
+        //! A request refused by acquire is answered locally with a 429, the caller has to send it again later
+        RestClient::Response get(const std::string& url, http_request_priority priority = http_request_priority::normal);
+        RestClient::Response
+        post(const std::string& url, const std::string& content_type, const std::string& data, http_request_priority priority = http_request_priority::normal);
+
+        static std::string extract_host(const std::string& url);
+    };
+
+    http_rate_limiter& get_http_rate_limiter() noexcept;
+} // namespace atomic_dex
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.http.rate.limiter.hpp"
+#include <doctest/doctest.h>
+
+TEST_CASE("atomic dex http rate limiter extract host")
+{
+    using atomic_dex::http_rate_limiter;
+    CHECK_EQ(http_rate_limiter::extract_host("https://api.coinpaprika.com/v1/tickers?quotes=USD"), "api.coinpaprika.com");
+    CHECK_EQ(http_rate_limiter::extract_host("http://komodo.live:3334/api/v1/ohlc/kmd-btc"), "komodo.live:3334");
+    CHECK_EQ(http_rate_limiter::extract_host("api.openrates.io?base=USD"), "api.openrates.io");
+}
+
+TEST_CASE("atomic dex http rate limiter token bucket")
+{
+    using namespace std::chrono;
+    atomic_dex::http_rate_limiter limiter;
+    limiter.set_host_limits("unit.test", {.requests_per_second = 20.0, .burst = 2.0});
+
+    const auto start = steady_clock::now();
+    for (int i = 0; i < 4; ++i) { limiter.acquire("unit.test", atomic_dex::http_request_priority::normal); }
+
+    //! The burst is served immediately, the two other tokens need ~50ms each
+    CHECK_GE(duration_cast<milliseconds>(steady_clock::now() - start).count(), 90);
+}
+
+TEST_CASE("atomic dex http rate limiter caps the blocked threads")
+{
+    using namespace std::chrono;
+    using atomic_dex::http_request_priority;
+    atomic_dex::http_rate_limiter limiter;
+    limiter.set_host_limits("unit.test", {.requests_per_second = 10.0, .burst = 1.0});
+    limiter.set_max_blocked_threads(1);
+
+    //! Empty the bucket, the next token comes in ~100ms
+    CHECK(limiter.acquire("unit.test", http_request_priority::normal));
+    auto waiter = std::async(std::launch::async, [&limiter]() { return limiter.acquire("unit.test", http_request_priority::low); });
+    std::this_thread::sleep_for(milliseconds(20));
+
+    //! One thread already sleeps, a low request is refused at once
+    auto start = steady_clock::now();
+    CHECK_FALSE(limiter.acquire("unit.test", http_request_priority::low));
+    CHECK_LT(duration_cast<milliseconds>(steady_clock::now() - start).count(), 50);
+
+    //! A refused request is answered locally without reaching the network
+    start           = steady_clock::now();
+    const auto resp = limiter.get("http://unit.test/v1/tickers", http_request_priority::low);
+    CHECK_EQ(resp.code, 429);
+    CHECK_EQ(resp.body, "rate limited locally");
+    CHECK_LT(duration_cast<milliseconds>(steady_clock::now() - start).count(), 50);
+
+    //! Normal and high requests are never refused, they wait for their token
+    CHECK(limiter.acquire("unit.test", http_request_priority::normal));
+    CHECK(limiter.acquire("unit.test", http_request_priority::high));
+    CHECK(waiter.get());
+}
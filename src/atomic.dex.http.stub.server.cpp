@@ -0,0 +1,256 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+//! Project Headers
+#include "atomic.dex.http.stub.server.hpp"
+
+namespace
+{
+    namespace asio = boost::asio;
+    using asio::ip::tcp;
+
+    //! Payloads recorded from the real services, trimmed to a few entries
+    constexpr const char* g_recorded_tickers = R"([
+        {"id":"btc-bitcoin","name":"Bitcoin","symbol":"BTC","quotes":{"USD":{"price":9143.71542532,"volume_24h":28560395272.43,"percent_change_24h":-0.17,"percent_change_7d":4.98},"BTC":{"price":1,"volume_24h":3123456.1,"percent_change_24h":0,"percent_change_7d":0}}},
+        {"id":"eth-ethereum","name":"Ethereum","symbol":"ETH","quotes":{"USD":{"price":245.13529964,"volume_24h":14435714623.098,"percent_change_24h":3.25,"percent_change_7d":8.94},"BTC":{"price":0.02680917,"volume_24h":1578766.2,"percent_change_24h":3.43,"percent_change_7d":3.77}}},
+        {"id":"kmd-komodo","name":"Komodo","symbol":"KMD","quotes":{"USD":{"price":0.64154101,"volume_24h":1383692.5082961,"percent_change_24h":-1.43,"percent_change_7d":6.83},"BTC":{"price":0.00007016,"volume_24h":151.32,"percent_change_24h":-1.26,"percent_change_7d":1.76}}},
+        {"id":"ltc-litecoin","name":"Litecoin","symbol":"LTC","quotes":{"USD":{"price":63.54798897,"volume_24h":3962425117.6077,"percent_change_24h":0.86,"percent_change_7d":7.37},"BTC":{"price":0.00694991,"volume_24h":433347.5,"percent_change_24h":1.03,"percent_change_7d":2.27}}}
+    ])";
+
+    constexpr const char* g_recorded_ticker = R"({"id":"kmd-komodo","name":"Komodo","symbol":"KMD","quotes":{"USD":{"price":0.64154101,"volume_24h":1383692.5082961,"percent_change_24h":-1.43,"percent_change_7d":6.83},"BTC":{"price":0.00007016,"volume_24h":151.32,"percent_change_24h":-1.26,"percent_change_7d":1.76}}})";
+
+    constexpr const char* g_recorded_historical = R"([
+        {"market_cap":69616966,"price":0.587165,"timestamp":"2020-03-01T00:00:00Z","volume_24h":695641},
+        {"market_cap":73140722,"price":0.616809,"timestamp":"2020-03-02T00:00:00Z","volume_24h":794110},
+        {"market_cap":73591240,"price":0.620508,"timestamp":"2020-03-03T00:00:00Z","volume_24h":1141006},
+        {"market_cap":74346224,"price":0.626711,"timestamp":"2020-03-04T00:00:00Z","volume_24h":1451238},
+        {"market_cap":76556127,"price":0.645202,"timestamp":"2020-03-05T00:00:00Z","volume_24h":1558428},
+        {"market_cap":76501543,"price":0.644677,"timestamp":"2020-03-06T00:00:00Z","volume_24h":1494849}
+    ])";
+
+    constexpr const char* g_recorded_ohlc = R"({
+        "60":[{"timestamp":1593341640,"open":0.0000677,"high":0.0000677,"low":0.0000677,"close":0.0000677,"volume":419.16,"quote_volume":0.028377132},
+              {"timestamp":1593341700,"open":0.0000677,"high":0.0000679,"low":0.0000676,"close":0.0000678,"volume":120.5,"quote_volume":0.0081699}],
+        "3600":[{"timestamp":1593338400,"open":0.0000671,"high":0.0000679,"low":0.0000670,"close":0.0000678,"volume":8419.16,"quote_volume":0.56877132}]
+    })";
+
+    constexpr const char* g_recorded_tickers_list = R"(["kmd-btc","btc-usdt","eth-btc","ltc-btc","kmd-eth"])";
+
+    constexpr const char* g_recorded_openrates = R"({"rates":{"EUR":0.8893,"GBP":0.8035,"JPY":107.62,"CHF":0.9464,"CAD":1.3563},"base":"USD","date":"2020-07-01"})";
+
+    std::string
+    make_http_answer(int code, const std::string& reason, const std::string& body, const std::string& extra_headers = "")
+    {
+        std::ostringstream ss;
+        ss << "HTTP/1.1 " << code << " " << reason << "\r\n"
+           << "Content-Type: application/json\r\n"
+           << "Content-Length: " << body.size() << "\r\n"
+           << extra_headers << "Connection: close\r\n\r\n"
+           << body;
+        return ss.str();
+    }
+
+    //! eg: GET //api/v1/ohlc/kmd-btc HTTP/1.1 -> /api/v1/ohlc/kmd-btc
+    std::string
+    extract_path(const std::string& request_line)
+    {
+        std::istringstream ss(request_line);
+        std::string        method;
+        std::string        target;
+        ss >> method >> target;
+
+        std::string path;
+        for (char c: target)
+        {
+            if (not(c == '/' && not path.empty() && path.back() == '/'))
+            {
+                path.push_back(c);
+            }
+        }
+        return path;
+    }
+} // namespace
+
+namespace atomic_dex
+{
+    http_stub_server::http_stub_server(http_stub_options options) :
+        m_acceptor(m_io_context, tcp::endpoint(asio::ip::make_address("127.0.0.1"), 0)), m_options(options), m_gen(options.seed)
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+    }
+
+    http_stub_server::~http_stub_server() noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        stop();
+    }
+
+    void
+    http_stub_server::add_route(std::string path_prefix, std::string body)
+    {
+        auto routes = m_routes.synchronize();
+        routes->emplace_back(std::move(path_prefix), std::move(body));
+
+        //! Longest prefix first so /v1/tickers/kmd-komodo/historical wins over /v1/tickers
+        std::stable_sort(routes->begin(), routes->end(), [](const auto& lhs, const auto& rhs) { return lhs.first.size() > rhs.first.size(); });
+    }
+
+    void
+    http_stub_server::add_recorded_routes()
+    {
+        add_route("/v1/tickers?", g_recorded_tickers);
+        add_route("/v1/tickers/", g_recorded_ticker);
+        add_route("/v1/tickers/kmd-komodo/historical", g_recorded_historical);
+        add_route("/api/v1/ohlc/", g_recorded_ohlc);
+        add_route("/api/v1/tickers_list", g_recorded_tickers_list);
+        add_route("/latest", g_recorded_openrates);
+    }
+
+    std::string
+    http_stub_server::find_route(const std::string& path) const
+    {
+        auto routes = m_routes.synchronize();
+        for (auto&& [prefix, body]: *routes)
+        {
+            if (boost::algorithm::starts_with(path, prefix))
+            {
+                return body;
+            }
+        }
+        return {};
+    }
+
+    void
+    http_stub_server::serve_one(tcp::socket& socket)
+    {
+        asio::streambuf           buffer;
+        boost::system::error_code ec;
+        asio::read_until(socket, buffer, "\r\n\r\n", ec);
+        if (ec)
+        {
+            return;
+        }
+
+        std::istream is(&buffer);
+        std::string  request_line;
+        std::getline(is, request_line);
+        const auto path = extract_path(request_line);
+        ++m_nb_requests;
+
+        if (m_options.latency.count() > 0)
+        {
+            std::this_thread::sleep_for(m_options.latency);
+        }
+
+        std::string                            answer;
+        std::uniform_real_distribution<double> distr(0.0, 1.0);
+        const double                           draw = distr(m_gen);
+        if (draw < m_options.too_many_requests_rate)
+        {
+            ++m_nb_injected_failures;
+            answer = make_http_answer(
+                429, "Too Many Requests", R"({"error":"Too many requests"})", "Retry-After: " + std::to_string(m_options.retry_after.count()) + "\r\n");
+        }
+        else if (draw < m_options.too_many_requests_rate + m_options.error_rate)
+        {
+            ++m_nb_injected_failures;
+            answer = make_http_answer(500, "Internal Server Error", R"({"error":"Internal server error"})");
+        }
+        else if (auto body = find_route(path); not body.empty())
+        {
+            answer = make_http_answer(200, "OK", body);
+        }
+        else
+        {
+            answer = make_http_answer(404, "Not Found", R"({"error":"id not found"})");
+        }
+        asio::write(socket, asio::buffer(answer), ec);
+        socket.shutdown(tcp::socket::shutdown_both, ec);
+    }
+
+    void
+    http_stub_server::start()
+    {
+        if (m_running.exchange(true))
+        {
+            return;
+        }
+
+        //! Connections are served one at a time, the injected failures follow the seed deterministically
+        m_server_thread = std::thread([this]() {
+            while (m_running)
+            {
+                tcp::socket               socket(m_io_context);
+                boost::system::error_code ec;
+                m_acceptor.accept(socket, ec);
+                if (ec || not m_running)
+                {
+                    continue;
+                }
+                serve_one(socket);
+            }
+        });
+    }
+
+    void
+    http_stub_server::stop() noexcept
+    {
+        if (not m_running.exchange(false))
+        {
+            return;
+        }
+
+        //! Wake up the blocking accept
+        boost::system::error_code ec;
+        tcp::socket               wake_up(m_io_context);
+        wake_up.connect(m_acceptor.local_endpoint(ec), ec);
+        if (m_server_thread.joinable())
+        {
+            m_server_thread.join();
+        }
+        m_acceptor.close(ec);
+    }
+
+    std::string
+    http_stub_server::get_base_url() const
+    {
+        return "http://127.0.0.1:" + std::to_string(m_acceptor.local_endpoint().port());
+    }
+
+    external_endpoints
+    http_stub_server::get_endpoints() const
+    {
+        const auto base_url = get_base_url();
+        return external_endpoints{.coinpaprika = base_url + "/v1/", .cex = base_url + "/", .openrates = base_url + "/"};
+    }
+
+    std::size_t
+    http_stub_server::get_nb_requests() const noexcept
+    {
+        return m_nb_requests;
+    }
+
+    std::size_t
+    http_stub_server::get_nb_injected_failures() const noexcept
+    {
+        return m_nb_injected_failures;
+    }
+} // namespace atomic_dex
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include "atomic.dex.pch.hpp"
+
+//! Project Headers
+#include "atomic.dex.http.endpoints.hpp"
+
+namespace atomic_dex
+{
+    struct http_stub_options
+    {
+        std::chrono::milliseconds latency{0};                  ///< added before every answer
+        double                    error_rate{0.0};             ///< probability of a 500 answer
+        double                    too_many_requests_rate{0.0}; ///< probability of a 429 answer
+        std::chrono::seconds      retry_after{0};              ///< Retry-After header of the 429 answers
+        std::uint32_t             seed{42};                    ///< same seed, same sequence of injected failures
+    };
+
+    //! Local stand-in of coinpaprika, the ohlc service and openrates replaying recorded payloads, used by the tests and the offline benchmarks
+    class http_stub_server
+    {
+        using t_routes = std::vector<std::pair<std::string, std::string>>;
+
+        boost::asio::io_context             m_io_context;
+        boost::asio::ip::tcp::acceptor      m_acceptor;
+        std::thread                         m_server_thread;
+        std::atomic_bool                    m_running{false};
+        http_stub_options                   m_options;
+        std::mt19937                        m_gen;
+        boost::synchronized_value<t_routes> m_routes;
+        std::atomic<std::size_t>            m_nb_requests{0};
+        std::atomic<std::size_t>            m_nb_injected_failures{0};
+
+        //! Private API
+        void        serve_one(boost::asio::ip::tcp::socket& socket);
+        std::string find_route(const std::string& path) const;
+
+      public:
+        //! Listen on a random local port
+        explicit http_stub_server(http_stub_options options = {});
+        ~http_stub_server() noexcept;
+
+        //! Answer 200 with this body to every GET whose path starts with path_prefix, the longest prefix wins
+        void add_route(std::string path_prefix, std::string body);
+
+        //! Recorded coinpaprika (tickers, ticker, historical), ohlc and openrates payloads
+        void add_recorded_routes();
+
+        void start();
+        void stop() noexcept;
+
+        //! eg: http://127.0.0.1:45123
+        [[nodiscard]] std::string get_base_url() const;
+
+        //! Endpoints to give to set_external_endpoints
+        [[nodiscard]] external_endpoints get_endpoints() const;
+
+        [[nodiscard]] std::size_t get_nb_requests() const noexcept;
+        [[nodiscard]] std::size_t get_nb_injected_failures() const noexcept;
+    };
+} // namespace atomic_dex
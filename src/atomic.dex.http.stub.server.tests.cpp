@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.http.stub.server.hpp"
+#include "atomic.dex.provider.cex.prices.api.hpp"
+#include "atomic.dex.provider.coinpaprika.api.hpp"
+#include <doctest/doctest.h>
+
+namespace
+{
+    //! Point the providers to the stub for the lifetime of the scope
+    struct scoped_endpoints
+    {
+        atomic_dex::external_endpoints previous{atomic_dex::get_external_endpoints()};
+
+        explicit scoped_endpoints(atomic_dex::external_endpoints endpoints) { atomic_dex::set_external_endpoints(std::move(endpoints)); }
+        ~scoped_endpoints() { atomic_dex::set_external_endpoints(previous); }
+    };
+} // namespace
+
+TEST_CASE("atomic dex http stub server replays recorded payloads")
+{
+    atomic_dex::http_stub_server stub;
+    stub.add_recorded_routes();
+    stub.start();
+    scoped_endpoints endpoints(stub.get_endpoints());
+
+    const auto tickers = atomic_dex::coinpaprika::api::tickers({.ticker_quotes = {"USD", "BTC"}});
+    CHECK_EQ(tickers.rpc_result_code, 200);
+    CHECK_GT(tickers.answer.size(), 0);
+
+    const auto historical = atomic_dex::coinpaprika::api::ticker_historical({.ticker_currency_id = "kmd-komodo"});
+    CHECK_EQ(historical.rpc_result_code, 200);
+    CHECK(historical.answer.is_array());
+
+    auto ohlc = atomic_dex::rpc_ohlc_get_data({.base_asset = "kmd", .quote_asset = "btc"});
+    CHECK_FALSE(ohlc.error.has_value());
+    CHECK_EQ(stub.get_nb_requests(), 3);
+}
+
+TEST_CASE("atomic dex http stub server benchmark with 429 injection")
+{
+    using namespace std::chrono;
+    constexpr std::size_t nb_calls = 50;
+
+    atomic_dex::http_stub_server stub({.latency = milliseconds(2), .too_many_requests_rate = 0.3, .seed = 1337});
+    stub.add_recorded_routes();
+    stub.start();
+    scoped_endpoints endpoints(stub.get_endpoints());
+    atomic_dex::get_http_rate_limiter().set_host_limits(
+        atomic_dex::http_rate_limiter::extract_host(stub.get_base_url()),
+        {.requests_per_second = 1000.0, .burst = 1000.0, .max_retries = 10, .base_backoff = milliseconds(1), .max_backoff = milliseconds(10)});
+
+    const auto  start      = steady_clock::now();
+    std::size_t nb_succeed = 0;
+    for (std::size_t idx = 0; idx < nb_calls; ++idx)
+    {
+        nb_succeed += atomic_dex::coinpaprika::api::tickers({.ticker_quotes = {"USD"}}).rpc_result_code == 200;
+    }
+    const auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start);
+
+    MESSAGE(nb_calls << " tickers calls in " << elapsed.count() << " ms, " << stub.get_nb_injected_failures() << " injected 429 retried");
+    CHECK_EQ(nb_succeed, nb_calls);
+    CHECK_EQ(stub.get_nb_requests(), nb_calls + stub.get_nb_injected_failures());
+}
@@ -1146,6 +1146,35 @@ namespace mm2::api
         return answer;
     }
 
+    nlohmann::json
+    rpc_batch_disable(std::vector<disable_coin_request> requests)
+    {
+        spdlog::info("Processing rpc call: batch disable_coin");
+
+        nlohmann::json req_json_data = nlohmann::json::array();
+        for (auto&& request: requests)
+        {
+            nlohmann::json json_data = template_request("disable_coin");
+            to_json(json_data, request);
+            req_json_data.push_back(json_data);
+        }
+
+        auto resp = RestClient::post(g_endpoint, "application/json", req_json_data.dump());
+        spdlog::info("{} resp code: {}", __FUNCTION__, resp.code);
+
+        nlohmann::json answer;
+        try
+        {
+            answer = nlohmann::json::parse(resp.body);
+        }
+        catch (const nlohmann::detail::parse_error& err)
+        {
+            spdlog::error("{}", err.what());
+            answer["error"] = resp.body;
+        }
+        return answer;
+    }
+
     static inline std::string&
     access_rpc_password() noexcept
     {
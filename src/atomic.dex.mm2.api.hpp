@@ -21,6 +21,7 @@
 
 //! Project Headers
 #include "atomic.dex.coins.config.hpp"
+#include "atomic.dex.http.rate.limiter.hpp"
 
 namespace mm2::api
 {
@@ -705,6 +706,7 @@ namespace mm2::api
 
     nlohmann::json rpc_batch_electrum(std::vector<electrum_request> requests);
     nlohmann::json rpc_batch_enable(std::vector<enable_request> requests);
+    nlohmann::json rpc_batch_disable(std::vector<disable_coin_request> requests);
 
     template <typename T>
     using have_error_field = decltype(std::declval<T&>().error.has_value());
@@ -786,11 +788,8 @@ namespace mm2::api
     {
         spdlog::info("Processing rpc call: {}, url: {}", rpc_command, url);
 
-        RestClient::Response resp;
-
-        resp = RestClient::get(url);
-
-
+        //! Explorer like endpoints (eg: komodo.live) are shared with the other providers, the history is only fetched once so it must never be refused
+        const auto resp = atomic_dex::get_http_rate_limiter().get(url, atomic_dex::http_request_priority::normal);
 
         return rpc_process_answer<TAnswer>(resp, rpc_command);
     }
@@ -823,6 +822,7 @@ namespace atomic_dex
     using t_electrum_request        = ::mm2::api::electrum_request;
     using t_enable_request          = ::mm2::api::enable_request;
     using t_disable_coin_request    = ::mm2::api::disable_coin_request;
+    using t_disable_coin_answer     = ::mm2::api::disable_coin_answer;
     using t_tx_history_request      = ::mm2::api::tx_history_request;
     using t_my_recent_swaps_answer  = ::mm2::api::my_recent_swaps_answer_success;
     using t_my_recent_swaps_request = ::mm2::api::my_recent_swaps_request;
@@ -19,6 +19,7 @@
 #include "atomic.dex.kill.hpp"
 #include "atomic.dex.mm2.config.hpp"
 #include "atomic.dex.security.hpp"
+#include "atomic.dex.startup.tracer.hpp"
 #include "atomic.dex.version.hpp"
 #include "atomic.threadpool.hpp"
 
@@ -27,6 +28,62 @@ namespace
 {
     namespace ag = antara::gaming;
 
+    //! Electrum servers answer one after the other inside a batch, small batches let the first coins be ready sooner
+    constexpr std::size_t g_enable_batch_chunk_size = 8;
+
+    //! mm2 is usually listening after a few hundred milliseconds, the probe delay doubles from 10ms up to 250ms
+    constexpr auto g_mm2_probe_initial_delay = std::chrono::milliseconds(10);
+    constexpr auto g_mm2_probe_max_delay     = std::chrono::milliseconds(250);
+    constexpr auto g_mm2_probe_timeout       = std::chrono::seconds(30);
+
+    //! Electrum servers of the enabled coins are probed again in background every 10 minutes
+    constexpr auto g_electrum_health_interval = std::chrono::minutes(10);
+
+    //! Errors of disable_coin that leave the coin running, any other error means mm2 no longer runs it
+    std::error_code
+    get_disable_error(const std::string& error) noexcept
+    {
+        if (error.find("such coin") != std::string::npos)
+        {
+            return dextop_error::disable_unknown_coin;
+        }
+        if (error.find("active swaps") != std::string::npos)
+        {
+            return dextop_error::active_swap_is_using_the_coin;
+        }
+        if (error.find("matching orders") != std::string::npos)
+        {
+            return dextop_error::order_is_matched_at_the_moment;
+        }
+        return {};
+    }
+
+    using t_startup_clock = std::chrono::steady_clock;
+
+    //! Log the duration of a startup phase, record it in the startup trace and start the next one
+    void
+    log_startup_phase(const char* phase, t_startup_clock::time_point& phase_start)
+    {
+        const auto now = t_startup_clock::now();
+        spdlog::info("mm2 startup phase [{}] took {} ms", phase, std::chrono::duration_cast<std::chrono::milliseconds>(now - phase_start).count());
+        atomic_dex::get_startup_tracer().record(phase, "mm2", phase_start, now);
+        phase_start = now;
+    }
+
+    template <typename TRequest>
+    std::vector<std::vector<TRequest>>
+    chunk_requests(std::vector<TRequest> requests, std::size_t chunk_size)
+    {
+        std::vector<std::vector<TRequest>> chunks;
+        chunks.reserve((requests.size() + chunk_size - 1) / chunk_size);
+        for (std::size_t idx = 0; idx < requests.size(); idx += chunk_size)
+        {
+            const auto last = std::min(requests.size(), idx + chunk_size);
+            chunks.emplace_back(std::make_move_iterator(requests.begin() + idx), std::make_move_iterator(requests.begin() + last));
+        }
+        return chunks;
+    }
+
     void
     check_for_reconfiguration(const std::string& wallet_name)
     {
@@ -69,9 +126,7 @@ namespace
             actual_version_ifs.close();
 
             //! Write contents
-            std::ofstream ofs(actual_version_filepath.string());
-            assert(ofs.is_open());
-            ofs << actual_config_data;
+            atomic_dex::wallet_coins_config::write_atomically(actual_version_filepath, actual_config_data);
 
             //! Delete old cfg
             boost::system::error_code ec;
@@ -83,29 +138,8 @@ namespace
         }
     }
 
-    void
-    update_coin_status(const std::string& wallet_name, const std::vector<std::string> tickers, bool status = true)
-    {
-        fs::path       cfg_path = get_atomic_dex_config_folder();
-        std::string    filename = std::string(atomic_dex::get_raw_version()) + "-coins." + wallet_name + ".json";
-        std::ifstream  ifs((cfg_path / filename).c_str());
-        nlohmann::json config_json_data;
-
-        assert(ifs.is_open());
-        ifs >> config_json_data;
-
-        for (auto&& ticker: tickers) { config_json_data.at(ticker)["active"] = status; }
-
-        ifs.close();
-
-        //! Write contents
-        std::ofstream ofs((cfg_path / filename).c_str(), std::ios::trunc);
-        assert(ofs.is_open());
-        ofs << config_json_data;
-    }
-
     bool
-    retrieve_coins_information(const std::string& wallet_name, atomic_dex::t_coins_registry& coins_registry)
+    retrieve_coins_information(const std::string& wallet_name, atomic_dex::wallet_coins_config& wallet_cfg, atomic_dex::t_coins_registry& coins_registry)
     {
         spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
 
@@ -113,13 +147,9 @@ namespace
         const auto  cfg_path = get_atomic_dex_config_folder();
         std::string filename = std::string(atomic_dex::get_raw_version()) + "-coins." + wallet_name + ".json";
         spdlog::info("Retrieving Wallet information of {}", (cfg_path / filename).string());
-        if (exists(cfg_path / filename))
+        if (wallet_cfg.load(cfg_path / filename))
         {
-            std::ifstream ifs((cfg_path / filename).c_str());
-            assert(ifs.is_open());
-            nlohmann::json config_json_data;
-            ifs >> config_json_data;
-            auto res = config_json_data.get<std::unordered_map<std::string, atomic_dex::coin_config>>();
+            auto res = wallet_cfg.get_config().get<std::unordered_map<std::string, atomic_dex::coin_config>>();
             for (auto&& [key, value]: res) { coins_registry.insert_or_assign(key, value); }
             return true;
         }
@@ -177,6 +207,7 @@ namespace atomic_dex
     mm2::~mm2() noexcept
     {
         m_mm2_running = false;
+        m_electrum_health.stop();
 
 #if defined(_WIN32) || defined(WIN32)
         atomic_dex::kill_executable("mm2");
@@ -210,71 +241,65 @@ namespace atomic_dex
         return m_mm2_running;
     }
 
-    t_coins
-    mm2::get_all_coins() const noexcept
+    std::shared_ptr<const coins_views>
+    mm2::get_coins_views() const noexcept
     {
-        t_coins destination;
-
-        destination.reserve(m_coins_informations.size());
-        for (auto&& [key, value]: m_coins_informations)
+        std::scoped_lock lock(m_coins_views_mutex);
+        const auto       version = m_coins_version.load();
+        if (m_coins_views != nullptr && m_coins_views->version == version)
         {
-            //!
-            destination.push_back(value);
+            return m_coins_views;
         }
 
-        std::sort(begin(destination), end(destination), [](auto&& lhs, auto&& rhs) { return lhs.ticker < rhs.ticker; });
+        //! The version is read before the registry, a change made during the rebuild bumps it again
+        t_coins all;
+        all.reserve(m_coins_informations.size());
+        for (auto&& [key, value]: m_coins_informations) { all.push_back(value); }
+        std::sort(begin(all), end(all), [](auto&& lhs, auto&& rhs) { return lhs.ticker < rhs.ticker; });
 
-        return destination;
-    }
-
-    t_coins
-    mm2::get_enabled_coins() const noexcept
-    {
-        t_coins destination;
-
-        for (auto&& [key, value]: m_coins_informations)
+        t_coins enabled;
+        t_coins enableable;
+        t_coins active;
+        for (auto&& coin: all)
         {
-            if (value.currently_enabled)
+            (coin.currently_enabled ? enabled : enableable).push_back(coin);
+            if (coin.active)
             {
-                destination.push_back(value);
+                active.push_back(coin);
             }
         }
 
-        std::sort(begin(destination), end(destination), [](auto&& lhs, auto&& rhs) { return lhs.ticker < rhs.ticker; });
-
-        return destination;
+        m_coins_views = std::make_shared<const coins_views>(coins_views{
+            .version    = version,
+            .all        = std::make_shared<const t_coins>(std::move(all)),
+            .enabled    = std::make_shared<const t_coins>(std::move(enabled)),
+            .enableable = std::make_shared<const t_coins>(std::move(enableable)),
+            .active     = std::make_shared<const t_coins>(std::move(active))});
+        return m_coins_views;
     }
 
-    t_coins
-    mm2::get_enableable_coins() const noexcept
+    t_coins_view
+    mm2::get_all_coins() const noexcept
     {
-        t_coins destination;
+        return get_coins_views()->all;
+    }
 
-        for (auto&& [key, value]: m_coins_informations)
-        {
-            if (not value.currently_enabled)
-            {
-                destination.emplace_back(value);
-            }
-        }
+    t_coins_view
+    mm2::get_enabled_coins() const noexcept
+    {
+        return get_coins_views()->enabled;
+    }
 
-        return destination;
+    t_coins_view
+    mm2::get_enableable_coins() const noexcept
+    {
+        return get_coins_views()->enableable;
     }
 
-    t_coins
+    t_coins_view
     mm2::get_active_coins() const noexcept
     {
-        t_coins destination;
-
-        for (auto&& [key, value]: m_coins_informations)
-        {
-            if (value.active)
-            {
-                destination.emplace_back(value);
-            }
-        }
-
-        return destination;
+        return get_coins_views()->active;
     }
 
     bool
@@ -291,28 +316,18 @@ namespace atomic_dex
 
         if (answer.error.has_value())
         {
-            std::string error = answer.error.value();
-            if (error.find("such coin") != std::string::npos)
-            {
-                ec = dextop_error::disable_unknown_coin;
-                return false;
-            }
-            else if (error.find("active swaps") != std::string::npos)
-            {
-                ec = dextop_error::active_swap_is_using_the_coin;
-                return false;
-            }
-            else if (error.find("matching orders") != std::string::npos)
+            ec = get_disable_error(answer.error.value());
+            if (ec)
             {
-                ec = dextop_error::order_is_matched_at_the_moment;
                 return false;
             }
         }
 
         coin_info.currently_enabled = false;
         m_coins_informations.assign(coin_info.ticker, coin_info);
+        ++m_coins_version;
 
-        dispatcher_.trigger<coin_disabled>(ticker);
+        dispatcher_.trigger<coins_disabled>(std::vector<std::string>{ticker});
         return true;
     }
 
@@ -328,7 +343,7 @@ namespace atomic_dex
 
         if (not coin_info.is_erc_20)
         {
-            t_electrum_request request{.coin_name = coin_info.ticker, .servers = coin_info.electrum_urls.value(), .with_tx_history = true};
+            t_electrum_request request{.coin_name = coin_info.ticker, .servers = m_electrum_health.rank(coin_info.electrum_urls.value()), .with_tx_history = true};
             const auto         answer = rpc_electrum(std::move(request));
             if (answer.result not_eq "success")
             {
@@ -348,6 +363,7 @@ namespace atomic_dex
 
         coin_info.currently_enabled = true;
         m_coins_informations.assign(coin_info.ticker, coin_info);
+        ++m_coins_version;
 
         spawn([this, copy_ticker = ticker]() { process_balance(copy_ticker); });
         spawn([this, copy_ticker = ticker]() { process_tx(copy_ticker, false); });
@@ -367,10 +383,11 @@ namespace atomic_dex
         auto                     coins = get_active_coins();
 
         std::vector<std::string> tickers;
-        tickers.reserve(coins.size());
-        for (auto&& current_coin: coins) { tickers.push_back(current_coin.ticker); }
+        tickers.reserve(coins->size());
+        for (auto&& current_coin: *coins) { tickers.push_back(current_coin.ticker); }
 
-        batch_enable_coins(tickers);
+        //! Called from the mm2 init thread which is not part of the pool, waiting here cannot starve the chunks
+        batch_enable_coins(tickers).wait();
 
         this->dispatcher_.trigger<enabled_default_coins_event>();
 
@@ -387,22 +404,87 @@ namespace atomic_dex
     {
         spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
 
-        for (const auto& ticker: tickers)
-        {
-            spawn([this, ticker]() {
-                std::error_code ec;
-                disable_coin(ticker, ec);
-                if (ec)
+        spawn([this, tickers]() {
+            //! Coins that are not running are already in the expected state
+            std::vector<std::string>            confirmed;
+            std::vector<t_disable_coin_request> requests;
+            for (auto&& ticker: tickers)
+            {
+                const auto it = m_coins_informations.find(ticker);
+                if (it == m_coins_informations.cend())
                 {
-                    spdlog::warn("{}", ec.message());
+                    spdlog::warn("cannot disable unknown coin {}", ticker);
                 }
-            });
-        }
+                else if (it->second.currently_enabled)
+                {
+                    requests.push_back({.coin = ticker});
+                }
+                else
+                {
+                    confirmed.push_back(ticker);
+                }
+            }
 
-        update_coin_status(this->m_current_wallet_name, tickers, false);
+            std::vector<std::string> disabled;
+            if (not requests.empty())
+            {
+                //! mm2 answers a batch in the same order as the requests
+                const auto answers = rpc_batch_disable(requests);
+                if (answers.is_array() && answers.size() == requests.size())
+                {
+                    for (std::size_t idx = 0; idx < requests.size(); ++idx)
+                    {
+                        const auto& ticker = requests[idx].coin;
+                        try
+                        {
+                            const auto answer = answers[idx].get<t_disable_coin_answer>();
+                            if (answer.error.has_value())
+                            {
+                                if (const auto ec = get_disable_error(answer.error.value()); ec)
+                                {
+                                    spdlog::warn("cannot disable {}: {}", ticker, ec.message());
+                                    continue;
+                                }
+                            }
+                            disabled.push_back(ticker);
+                        }
+                        catch (const std::exception& error)
+                        {
+                            //! Without a readable answer the coin is considered still running
+                            spdlog::error("invalid disable answer for {}: {}", ticker, error.what());
+                        }
+                    }
+                }
+                else
+                {
+                    spdlog::error("unexpected batch disable answer: {}", answers.dump());
+                }
+            }
+
+            for (auto&& ticker: disabled)
+            {
+                if (const auto it = m_coins_informations.find(ticker); it != m_coins_informations.cend())
+                {
+                    coin_config coin_info       = it->second;
+                    coin_info.currently_enabled = false;
+                    m_coins_informations.assign(coin_info.ticker, coin_info);
+                }
+            }
+
+            confirmed.insert(confirmed.end(), disabled.begin(), disabled.end());
+            if (not confirmed.empty())
+            {
+                ++m_coins_version;
+                m_wallet_coins_cfg.set_active(confirmed, false);
+            }
+            if (not disabled.empty())
+            {
+                dispatcher_.trigger<coins_disabled>(std::move(disabled));
+            }
+        });
     }
 
-    void
+    std::future<void>
     mm2::batch_enable_coins(const std::vector<std::string>& tickers, bool emit_event) noexcept
     {
         std::vector<t_electrum_request> requests;
@@ -410,8 +492,14 @@ namespace atomic_dex
 
         for (const auto& ticker: tickers)
         {
-            coin_config coin_info = m_coins_informations.at(ticker);
+            const auto it = m_coins_informations.find(ticker);
+            if (it == m_coins_informations.cend())
+            {
+                spdlog::warn("cannot enable unknown coin {}", ticker);
+                continue;
+            }
 
+            const coin_config& coin_info = it->second;
             if (coin_info.currently_enabled)
             {
                 continue;
@@ -419,7 +507,7 @@ namespace atomic_dex
 
             if (not coin_info.is_erc_20)
             {
-                t_electrum_request request{.coin_name = coin_info.ticker, .servers = coin_info.electrum_urls.value(), .with_tx_history = true};
+                t_electrum_request request{.coin_name = coin_info.ticker, .servers = m_electrum_health.rank(coin_info.electrum_urls.value()), .with_tx_history = true};
                 requests.emplace_back(request);
             }
             else
@@ -429,50 +517,117 @@ namespace atomic_dex
             }
         }
 
-        auto functor_process_answer = [this, &emit_event](const nlohmann::json& answer) {
-            if (answer.count("coin") == 1)
-            {
-                auto        ticker          = answer.at("coin").get<std::string>();
-                coin_config coin_info       = m_coins_informations.at(ticker);
-                coin_info.currently_enabled = true;
-                m_coins_informations.assign(coin_info.ticker, coin_info);
+        std::promise<void> batch_done;
+        auto               result   = batch_done.get_future();
+        const std::size_t  nb_coins = requests.size() + requests_erc.size();
+        if (nb_coins == 0)
+        {
+            batch_done.set_value();
+            return result;
+        }
+        update_activation_progress(nb_coins, 0, 0);
 
-                process_balance(ticker);
-                process_tx(ticker, false);
+        //! No chunk waits for another one, the last chunk to finish completes the batch
+        auto electrum_chunks = chunk_requests(std::move(requests), g_enable_batch_chunk_size);
+        auto erc_chunks      = chunk_requests(std::move(requests_erc), g_enable_batch_chunk_size);
+        auto nb_pending      = std::make_shared<std::atomic_size_t>(electrum_chunks.size() + erc_chunks.size());
+        auto shared_done     = std::make_shared<std::promise<void>>(std::move(batch_done));
 
-                dispatcher_.trigger<coin_enabled>(ticker);
-                if (emit_event)
+        auto functor_run_chunk = [this, emit_event, nb_pending, shared_done](auto&& rpc, auto&& chunk) {
+            spawn([this, emit_event, nb_pending, shared_done, rpc, chunk = std::move(chunk)]() {
+                try
                 {
-                    this->dispatcher_.trigger<enabled_coins_event>();
+                    process_enable_answers(rpc(chunk), chunk.size(), emit_event);
                 }
-            }
+                catch (const std::exception& error)
+                {
+                    spdlog::error("batch enable chunk failed: {}", error.what());
+                    update_activation_progress(0, 0, chunk.size());
+                }
+                if (nb_pending->fetch_sub(1) == 1)
+                {
+                    shared_done->set_value();
+                }
+            });
         };
+        for (auto&& chunk: electrum_chunks) { functor_run_chunk(&::mm2::api::rpc_batch_electrum, std::move(chunk)); }
+        for (auto&& chunk: erc_chunks) { functor_run_chunk(&::mm2::api::rpc_batch_enable, std::move(chunk)); }
+        return result;
+    }
 
-        if (not requests.empty())
+    void
+    mm2::process_enable_answers(const nlohmann::json& answers, std::size_t nb_requests, bool emit_event)
+    {
+        if (answers.count("error") != 0 || not answers.is_array())
         {
-            auto answers = rpc_batch_electrum(requests);
-            if (answers.count("error") == 0)
-            {
-                for (auto&& answer: answers) { functor_process_answer(answer); }
-            }
+            spdlog::error("batch enable error: {}", answers.dump());
+            update_activation_progress(0, 0, nb_requests);
+            return;
         }
 
-        if (not requests_erc.empty())
+        for (auto&& answer: answers)
         {
-            auto answers_erc = rpc_batch_enable(requests_erc);
-            if (answers_erc.count("error") == 0)
+            std::string ticker;
+            try
+            {
+                if (answer.count("coin") == 1)
+                {
+                    ticker = answer.at("coin").get<std::string>();
+                }
+            }
+            catch (const std::exception& error)
             {
-                for (auto&& answer_erc: answers_erc) { functor_process_answer(answer_erc); }
+                spdlog::error("invalid enable answer: {}", error.what());
             }
+
+            const auto it = ticker.empty() ? m_coins_informations.cend() : m_coins_informations.find(ticker);
+            if (it == m_coins_informations.cend())
+            {
+                spdlog::warn("unable to enable a coin: {}", answer.dump());
+                update_activation_progress(0, 0, 1);
+                continue;
+            }
+
+            coin_config coin_info       = it->second;
+            coin_info.currently_enabled = true;
+            m_coins_informations.assign(coin_info.ticker, coin_info);
+            ++m_coins_version;
+
+            //! Balance and history of this coin don't wait for the other answers
+            spawn([this, ticker]() { process_balance(ticker); });
+            spawn([this, ticker]() { process_tx(ticker, false); });
+
+            dispatcher_.trigger<coin_enabled>(ticker);
+            if (emit_event)
+            {
+                this->dispatcher_.trigger<enabled_coins_event>();
+            }
+            update_activation_progress(0, 1, 0);
+        }
+    }
+
+    void
+    mm2::update_activation_progress(std::size_t nb_new_to_enable, std::size_t nb_new_enabled, std::size_t nb_failed) noexcept
+    {
+        //! Published under the lock so the last event is the final state, a failed coin is removed from the total so the progress can still reach it
+        std::scoped_lock lock(m_activation_progress_mutex);
+        m_activation_progress.nb_total += nb_new_to_enable;
+        m_activation_progress.nb_total -= nb_failed;
+        m_activation_progress.nb_enabled += nb_new_enabled;
+        this->dispatcher_.trigger<coins_activation_progress>(m_activation_progress);
+        if (m_activation_progress.nb_enabled == m_activation_progress.nb_total)
+        {
+            m_activation_progress = coins_activation_progress{};
         }
     }
 
     void
     mm2::enable_multiple_coins(const std::vector<std::string>& tickers) noexcept
     {
+        //! The future is dropped, the chunks complete on their own
         spawn([this, tickers]() { batch_enable_coins(tickers, true); });
 
-        update_coin_status(this->m_current_wallet_name, tickers, true);
+        m_wallet_coins_cfg.set_active(tickers, true);
     }
 
     coin_config
@@ -650,12 +805,12 @@ namespace atomic_dex
     {
         spdlog::info("{}: Fetching Infos l{}", __FUNCTION__, __LINE__);
 
-        t_coins                        coins = get_enabled_coins();
+        const auto                     coins = get_enabled_coins();
         std::vector<std::future<void>> futures;
 
-        futures.reserve(coins.size() * 2);
+        futures.reserve(coins->size() * 2);
 
-        for (auto&& current_coin: coins)
+        for (auto&& current_coin: *coins)
         {
             futures.emplace_back(spawn([this, ticker = current_coin.ticker]() { process_balance(ticker); }));
             futures.emplace_back(spawn([this, ticker = current_coin.ticker, is_a_refresh]() { process_tx(ticker, is_a_refresh); }));
@@ -667,11 +822,28 @@ namespace atomic_dex
     void
     mm2::spawn_mm2_instance(std::string wallet_name, std::string passphrase, bool with_pin_cfg)
     {
-        this->m_balance_factor = determine_balance_factor(with_pin_cfg);
+        const auto startup_start = t_startup_clock::now();
+        auto       phase_start   = startup_start;
+        this->m_balance_factor   = determine_balance_factor(with_pin_cfg);
         spdlog::trace("balance factor is: {}", m_balance_factor);
         spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
         this->m_current_wallet_name = std::move(wallet_name);
-        retrieve_coins_information(this->m_current_wallet_name, m_coins_informations);
+        retrieve_coins_information(this->m_current_wallet_name, m_wallet_coins_cfg, m_coins_informations);
+        ++m_coins_version;
+        log_startup_phase("coins configuration", phase_start);
+        m_electrum_health.start(
+            [this]() {
+                std::vector<electrum_server> servers;
+                for (auto&& coin: *get_all_coins())
+                {
+                    if ((coin.active || coin.currently_enabled) && coin.electrum_urls.has_value())
+                    {
+                        servers.insert(servers.end(), coin.electrum_urls->begin(), coin.electrum_urls->end());
+                    }
+                }
+                return servers;
+            },
+            g_electrum_health_interval);
         mm2_config cfg{.passphrase = std::move(passphrase), .rpc_password = atomic_dex::gen_random_password()};
         ::mm2::api::set_rpc_password(cfg.rpc_password);
         json       json_cfg;
@@ -683,6 +855,7 @@ namespace atomic_dex
         std::ofstream ofs(mm2_cfg_path.string());
         ofs << json_cfg.dump();
         ofs.close();
+        log_startup_phase("mm2 configuration", phase_start);
         const std::array<std::string, 1> args = {(tools_path / "mm2").string()};
         reproc::options                  options;
         options.redirect.parent = true;
@@ -703,31 +876,38 @@ namespace atomic_dex
         {
             spdlog::error("{}", ec.message());
         }
+        log_startup_phase("mm2 process start", phase_start);
 
-        m_mm2_init_thread = std::thread([this, mm2_cfg_path]() {
-            using namespace std::chrono_literals;
-            auto               check_mm2_alive = []() { return ::mm2::api::rpc_version() != "error occured during rpc_version"; };
-            static std::size_t nb_try          = 0;
+        m_mm2_init_thread = std::thread([this, mm2_cfg_path, startup_start, phase_start]() mutable {
+            auto        check_mm2_alive = []() { return ::mm2::api::rpc_version() != "error occured during rpc_version"; };
+            auto        probe_delay     = g_mm2_probe_initial_delay;
+            const auto  deadline        = t_startup_clock::now() + g_mm2_probe_timeout;
+            std::size_t nb_probes       = 1;
 
+            //! Exponential probe, a refused connection answers immediately so an early probe is cheap
             while (not check_mm2_alive())
             {
-                nb_try += 1;
-                if (nb_try == 30)
+                if (t_startup_clock::now() >= deadline)
                 {
-                    spdlog::error("MM2 not started correctly");
+                    spdlog::error("MM2 not started correctly after {} probes", nb_probes);
                     //! TODO: emit mm2_failed_initialization
                     fs::remove(mm2_cfg_path);
                     return;
                 }
-                std::this_thread::sleep_for(1s);
+                std::this_thread::sleep_for(probe_delay);
+                probe_delay = std::min(probe_delay * 2, g_mm2_probe_max_delay);
+                nb_probes += 1;
             }
 
             fs::remove(mm2_cfg_path);
-            spdlog::info("mm2 is initialized");
+            spdlog::info("mm2 is initialized after {} probes", nb_probes);
+            log_startup_phase("mm2 rpc ready", phase_start);
             dispatcher_.trigger<mm2_initialized>();
             enable_default_coins();
+            log_startup_phase("default coins enabled", phase_start);
             m_mm2_running = true;
             dispatcher_.trigger<mm2_started>();
+            log_startup_phase("total", startup_start);
         });
     }
 
@@ -828,6 +1008,7 @@ namespace atomic_dex
             }
         }
 
+        startup_span      span("process_balance " + ticker, "mm2");
         t_balance_request balance_request{.coin = ticker};
         auto              answer = rpc_balance(std::move(balance_request));
         if (answer.raw_result.find("error") == std::string::npos)
@@ -1066,8 +1247,8 @@ namespace atomic_dex
     {
         auto                                      coins = get_enabled_coins();
         std::vector<::mm2::api::my_orders_answer> out;
-        out.reserve(coins.size());
-        for (auto&& coin: coins) { out.emplace_back(get_orders(coin.ticker, ec)); }
+        out.reserve(coins->size());
+        for (auto&& coin: *coins) { out.emplace_back(get_orders(coin.ticker, ec)); }
         return out;
     }
 
@@ -1205,10 +1386,9 @@ namespace atomic_dex
     mm2::get_raw_mm2_ticker_cfg(const std::string& ticker) const noexcept
     {
         nlohmann::json out;
-        if (m_mm2_raw_coins_cfg.find(ticker) != m_mm2_raw_coins_cfg.end())
+        if (auto element = m_mm2_raw_coins_cfg.get(ticker); element.has_value())
         {
-            atomic_dex::coin_element element = m_mm2_raw_coins_cfg.at(ticker);
-            to_json(out, element);
+            to_json(out, element.value());
             return out;
         }
         return nlohmann::json::object();
@@ -21,11 +21,13 @@
 
 //! Project Headers
 #include "atomic.dex.coins.config.hpp"
+#include "atomic.dex.electrum.health.hpp"
 #include "atomic.dex.events.hpp"
 #include "atomic.dex.mm2.api.hpp"
 #include "atomic.dex.mm2.error.code.hpp"
-#include "atomic.dex.raw.mm2.coins.cfg.hpp"
+#include "atomic.dex.raw.mm2.coins.index.hpp"
 #include "atomic.dex.utilities.hpp"
+#include "atomic.dex.wallet.coins.config.hpp"
 
 namespace atomic_dex
 {
@@ -65,6 +67,17 @@ namespace atomic_dex
     using t_wallet_cfg_registry = t_concurrent_reg<std::string, t_coins_registry>;
     using t_transactions        = std::vector<tx_infos>;
     using t_coins               = std::vector<coin_config>;
+    using t_coins_view          = std::shared_ptr<const t_coins>;
+
+    //! Coin lists sorted by ticker, rebuilt only when the enabled state of a coin changes
+    struct coins_views
+    {
+        std::uint64_t version;
+        t_coins_view  all;
+        t_coins_view  enabled;
+        t_coins_view  enableable;
+        t_coins_view  active;
+    };
 
     //! Constants
     inline constexpr const std::size_t g_tx_max_limit{50_sz};
@@ -107,16 +120,33 @@ namespace atomic_dex
         //! Current wallet name
         std::string m_current_wallet_name;
 
+        //! Coins status of the current wallet, written behind
+        wallet_coins_config m_wallet_coins_cfg;
+
         //! Concurrent Registry.
-        t_coins_registry&        m_coins_informations{entity_registry_.set<t_coins_registry>()};
-        t_balance_registry&      m_balance_informations{entity_registry_.set<t_balance_registry>()};
-        t_tx_history_registry    m_tx_informations;
-        t_tx_state_registry      m_tx_state;
-        t_my_orders              m_orders_registry;
-        t_fees_registry          m_trade_fees_registry;
-        t_orderbook_registry     m_current_orderbook;
-        t_swaps_registry         m_swaps_registry;
-        t_mm2_raw_coins_registry m_mm2_raw_coins_cfg{parse_raw_mm2_coins_file()};
+        t_coins_registry&     m_coins_informations{entity_registry_.set<t_coins_registry>()};
+        t_balance_registry&   m_balance_informations{entity_registry_.set<t_balance_registry>()};
+        t_tx_history_registry m_tx_informations;
+        t_tx_state_registry   m_tx_state;
+        t_my_orders           m_orders_registry;
+        t_fees_registry       m_trade_fees_registry;
+        t_orderbook_registry  m_current_orderbook;
+        t_swaps_registry      m_swaps_registry;
+
+        //! Views of m_coins_informations, m_coins_version is bumped after each change of the registry
+        std::atomic<std::uint64_t>                 m_coins_version{0};
+        mutable std::mutex                         m_coins_views_mutex;
+        mutable std::shared_ptr<const coins_views> m_coins_views;
+
+        //! Raw mm2 coins file, a coin is only decoded when the trading page asks for it
+        raw_mm2_coins_index m_mm2_raw_coins_cfg{ag::core::assets_real_path() / "tools" / "mm2" / "coins", get_atomic_dex_raw_coins_index_file()};
+
+        //! Latency of the electrum servers of the enabled coins, the fastest ones are given first to mm2
+        electrum_health_monitor m_electrum_health{get_atomic_dex_electrum_scores_file()};
+
+        //! Progress of all the batches being enabled, reset once every coin of them is processed
+        std::mutex                m_activation_progress_mutex;
+        coins_activation_progress m_activation_progress;
 
         //! Balance factor
         double m_balance_factor{1.0};
@@ -136,6 +166,12 @@ namespace atomic_dex
         //! Refresh the orderbook registry (internal)
         void process_orderbook(bool is_a_reset = false);
 
+        //! Mark the coins of a batch enable answer as enabled (internal)
+        void process_enable_answers(const nlohmann::json& answers, std::size_t nb_requests, bool emit_event);
+
+        //! Update the progress shared by every batch being enabled and publish it (internal)
+        void update_activation_progress(std::size_t nb_new_to_enable, std::size_t nb_new_enabled, std::size_t nb_failed) noexcept;
+
         //! Batch process fees and fetch current_orderbook thread
         void batch_process_fees_and_fetch_current_orderbook_thread(bool is_a_reset);
 
@@ -174,8 +210,9 @@ namespace atomic_dex
         //! Enable coins
         bool enable_default_coins() noexcept;
 
-        //! Batch Enable coins
-        void batch_enable_coins(const std::vector<std::string>& tickers, bool emit_event = false) noexcept;
+        //! Batch Enable coins, chunks are sent concurrently and each coin is processed as soon as its chunk answers
+        //! Never blocks, the returned future is ready once every chunk has been processed
+        std::future<void> batch_enable_coins(const std::vector<std::string>& tickers, bool emit_event = false) noexcept;
 
         //! Enable multiple coins
         void enable_multiple_coins(const std::vector<std::string>& tickers) noexcept;
@@ -186,7 +223,7 @@ namespace atomic_dex
         //! Disable a single coin
         bool disable_coin(const std::string& ticker, std::error_code& ec) noexcept;
 
-        //! Disable multiple coins, prefer this function if you want persistent disabling
+        //! Disable multiple coins in background with a single batch request, the confirmed ones are persisted as inactive
         void disable_multiple_coins(const std::vector<std::string>& tickers) noexcept;
 
         //! Called every ticks, and execute tasks if the timer expire.
@@ -231,17 +268,20 @@ namespace atomic_dex
         //! Send Rewards
         t_broadcast_answer send_rewards(t_broadcast_request&& req, t_mm2_ec& ec) noexcept;
 
+        //! Get the coin lists, the views are shared and immutable, a new one is built after a coin is enabled or disabled
+        [[nodiscard]] std::shared_ptr<const coins_views> get_coins_views() const noexcept;
+
         //! Get coins that are currently enabled
-        [[nodiscard]] t_coins get_enabled_coins() const noexcept;
+        [[nodiscard]] t_coins_view get_enabled_coins() const noexcept;
 
         //! Get coins that are active, but may be not enabled
-        [[nodiscard]] t_coins get_active_coins() const noexcept;
+        [[nodiscard]] t_coins_view get_active_coins() const noexcept;
 
         //! Get coins that can be activated
-        [[nodiscard]] t_coins get_enableable_coins() const noexcept;
+        [[nodiscard]] t_coins_view get_enableable_coins() const noexcept;
 
         //! Get all coins
-        [[nodiscard]] t_coins get_all_coins() const noexcept;
+        [[nodiscard]] t_coins_view get_all_coins() const noexcept;
         ;
 
         //! Get Specific info about one coin
@@ -15,11 +15,8 @@
  ******************************************************************************/
 
 #include "atomic.dex.provider.cex.prices.api.hpp"
-
-namespace atomic_dex
-{
-    inline constexpr const char* g_cex_endpoint = "https://komodo.live:3333/";
-}
+#include "atomic.dex.http.endpoints.hpp"
+#include "atomic.dex.http.rate.limiter.hpp"
 
 //! Json Serialization / Deserialization functions
 namespace atomic_dex
@@ -64,6 +61,20 @@ namespace atomic_dex
         }
     }
 
+    void
+    from_json(const nlohmann::json& j, ohlc_tickers_list_answer& answer)
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        if (j.is_array())
+        {
+            std::vector<std::string> tickers;
+            tickers.reserve(j.size());
+            for (auto&& cur: j) { tickers.emplace_back(boost::algorithm::to_lower_copy(cur.get<std::string>())); }
+            answer.result = std::move(tickers);
+        }
+    }
+
     ohlc_answer
     rpc_ohlc_get_data(ohlc_request&& request)
     {
@@ -72,8 +83,41 @@ namespace atomic_dex
 
         spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
         auto&& [base_id, quote_id] = request;
-        const auto url             = g_cex_endpoint + "/api/v1/ohlc/"s + base_id + "-"s + quote_id;
-        const auto resp            = RestClient::get(url);
+        const auto url             = get_external_endpoints().cex + "api/v1/ohlc/"s + base_id + "-"s + quote_id;
+        const auto resp            = get_http_rate_limiter().get(url, http_request_priority::high);
+
+        spdlog::info("url: {}", url);
+        spdlog::info("{} l{} resp code: {}", __FUNCTION__, __LINE__, resp.code);
+
+        if (resp.code != 200)
+        {
+            answer.error = "error occured, code : "s + std::to_string(resp.code);
+        }
+        else
+        {
+            try
+            {
+                const auto json_answer = nlohmann::json::parse(resp.body);
+                from_json(json_answer, answer);
+            }
+            catch (const std::exception& error)
+            {
+                spdlog::warn("{}", error.what());
+                answer.error = error.what();
+            }
+        }
+        return answer;
+    }
+
+    ohlc_tickers_list_answer
+    rpc_ohlc_get_tickers_list()
+    {
+        using namespace std::string_literals;
+        ohlc_tickers_list_answer answer;
+
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        const auto url  = get_external_endpoints().cex + "api/v1/tickers_list"s;
+        const auto resp = get_http_rate_limiter().get(url, http_request_priority::low);
 
         spdlog::info("url: {}", url);
         spdlog::info("{} l{} resp code: {}", __FUNCTION__, __LINE__, resp.code);
@@ -52,9 +52,17 @@ namespace atomic_dex
         std::optional<std::string>         error;
     };
 
+    struct ohlc_tickers_list_answer
+    {
+        std::optional<std::vector<std::string>> result;
+        std::optional<std::string>              error;
+    };
+
     void from_json(const nlohmann::json& j, ohlc_answer_success& answer);
     void from_json(const nlohmann::json& j, ohlc_answer& answer);
+    void from_json(const nlohmann::json& j, ohlc_tickers_list_answer& answer);
 
-    ohlc_answer rpc_ohlc_get_data(ohlc_request&& request);
+    ohlc_answer              rpc_ohlc_get_data(ohlc_request&& request);
+    ohlc_tickers_list_answer rpc_ohlc_get_tickers_list();
 
 } // namespace atomic_dex
\ No newline at end of file
@@ -54,4 +54,14 @@ TEST_CASE("rpc ohlc")
     CHECK(answer.result.has_value());
     CHECK_GT(answer.result.value().result.size(), 0);
     CHECK(answer.result.value().raw_result.contains("60"));
-}
\ No newline at end of file
+}
+
+TEST_CASE("ohlc tickers list answer")
+{
+    auto j = R"(["KMD-BTC", "eth-btc"])"_json;
+
+    atomic_dex::ohlc_tickers_list_answer answer;
+    CHECK_NOTHROW(atomic_dex::from_json(j, answer));
+    REQUIRE(answer.result.has_value());
+    CHECK_EQ(answer.result.value().front(), "kmd-btc");
+}
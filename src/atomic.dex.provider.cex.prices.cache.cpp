@@ -0,0 +1,271 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <boost/algorithm/string/predicate.hpp>
+
+//! Project Headers
+#include "atomic.dex.provider.cex.prices.cache.hpp"
+
+namespace
+{
+    constexpr std::array<char, 4> g_ohlc_cache_magic{'O', 'H', 'L', 'C'};
+    constexpr std::uint32_t       g_ohlc_cache_version     = 1;
+    constexpr std::size_t         g_ohlc_cache_header_size = g_ohlc_cache_magic.size() + sizeof(g_ohlc_cache_version);
+    constexpr const char*         g_ohlc_cache_extension   = ".ohlc";
+
+    bool
+    write_header(std::ostream& os)
+    {
+        os.write(g_ohlc_cache_magic.data(), g_ohlc_cache_magic.size());
+        os.write(reinterpret_cast<const char*>(&g_ohlc_cache_version), sizeof(g_ohlc_cache_version));
+        return os.good();
+    }
+
+    bool
+    check_header(std::istream& is)
+    {
+        std::array<char, 4> magic{};
+        std::uint32_t       version = 0;
+        is.read(magic.data(), magic.size());
+        is.read(reinterpret_cast<char*>(&version), sizeof(version));
+        return is.good() && magic == g_ohlc_cache_magic && version == g_ohlc_cache_version;
+    }
+} // namespace
+
+//! Json Serialization / Deserialization functions
+namespace atomic_dex
+{
+    void
+    to_json(nlohmann::json& j, const ohlc_candle& candle)
+    {
+        j["timestamp"]    = candle.timestamp;
+        j["open"]         = candle.open;
+        j["high"]         = candle.high;
+        j["low"]          = candle.low;
+        j["close"]        = candle.close;
+        j["volume"]       = candle.volume;
+        j["quote_volume"] = candle.quote_volume;
+    }
+
+    void
+    from_json(const nlohmann::json& j, ohlc_candle& candle)
+    {
+        j.at("timestamp").get_to(candle.timestamp);
+        j.at("open").get_to(candle.open);
+        j.at("high").get_to(candle.high);
+        j.at("low").get_to(candle.low);
+        j.at("close").get_to(candle.close);
+        j.at("volume").get_to(candle.volume);
+        j.at("quote_volume").get_to(candle.quote_volume);
+    }
+} // namespace atomic_dex
+
+namespace atomic_dex
+{
+    ohlc_candles_cache::ohlc_candles_cache(fs::path cache_folder, std::size_t max_candles_per_range) :
+        m_cache_folder(std::move(cache_folder)), m_max_candles_per_range(max_candles_per_range)
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+    }
+
+    fs::path
+    ohlc_candles_cache::get_range_path(const std::string& base, const std::string& quote, const std::string& range) const noexcept
+    {
+        return m_cache_folder / (base + "-" + quote + "." + range + g_ohlc_cache_extension);
+    }
+
+    ohlc_candles_cache::t_candles
+    ohlc_candles_cache::read_range(const fs::path& path) const noexcept
+    {
+        t_candles     candles;
+        std::ifstream ifs(path.string(), std::ios::binary);
+        if (not ifs.is_open())
+        {
+            return candles;
+        }
+
+        if (not check_header(ifs))
+        {
+            spdlog::warn("{} has an unknown layout, ignoring it", path.string());
+            return candles;
+        }
+
+        boost::system::error_code ec;
+        const auto                file_size = fs::file_size(path, ec);
+        if (not ec && file_size > g_ohlc_cache_header_size)
+        {
+            //! A truncated trailing record (crash during append) is simply dropped
+            candles.resize((file_size - g_ohlc_cache_header_size) / sizeof(ohlc_candle));
+            ifs.read(reinterpret_cast<char*>(candles.data()), candles.size() * sizeof(ohlc_candle));
+            candles.resize(ifs.gcount() / sizeof(ohlc_candle));
+        }
+        return candles;
+    }
+
+    void
+    ohlc_candles_cache::rewrite_range(const fs::path& path, const t_candles& candles) const noexcept
+    {
+        const fs::path tmp_path = fs::path(path).replace_extension(".tmp");
+        {
+            std::ofstream ofs(tmp_path.string(), std::ios::binary | std::ios::trunc);
+            if (not ofs.is_open() || not write_header(ofs))
+            {
+                spdlog::error("cannot write ohlc cache file: {}", tmp_path.string());
+                return;
+            }
+            ofs.write(reinterpret_cast<const char*>(candles.data()), candles.size() * sizeof(ohlc_candle));
+        }
+
+        boost::system::error_code ec;
+        fs::rename(tmp_path, path, ec);
+        if (ec)
+        {
+            spdlog::error("error: {}", ec.message());
+            fs::remove(tmp_path, ec);
+        }
+    }
+
+    nlohmann::json
+    ohlc_candles_cache::load(const std::string& base, const std::string& quote) noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        std::scoped_lock lock(m_cache_mutex);
+        nlohmann::json   out    = nlohmann::json::object();
+        const auto       prefix = base + "-" + quote + ".";
+
+        boost::system::error_code ec;
+        for (fs::directory_iterator it(m_cache_folder, ec), end; not ec && it != end; it.increment(ec))
+        {
+            const auto& path     = it->path();
+            const auto  filename = path.filename().string();
+            if (path.extension() != g_ohlc_cache_extension || not boost::algorithm::starts_with(filename, prefix))
+            {
+                continue;
+            }
+
+            const auto range   = path.stem().string().substr(prefix.size());
+            const auto candles = read_range(path);
+            if (not candles.empty())
+            {
+                out[range] = candles;
+            }
+        }
+        return out;
+    }
+
+    nlohmann::json
+    ohlc_candles_cache::merge(const std::string& base, const std::string& quote, const nlohmann::json& raw_ohlc) noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        std::scoped_lock lock(m_cache_mutex);
+        nlohmann::json   out = nlohmann::json::object();
+
+        for (auto&& [range, fetched]: raw_ohlc.items())
+        {
+            const auto path    = get_range_path(base, quote, range);
+            auto       candles = read_range(path);
+
+            //! Everything after first_dirty_idx has to be written back to disk
+            const std::size_t nb_cached       = candles.size();
+            std::size_t       first_dirty_idx = nb_cached;
+            for (auto&& cur_json: fetched)
+            {
+                ohlc_candle candle{};
+                try
+                {
+                    candle = cur_json.get<ohlc_candle>();
+                }
+                catch (const std::exception& error)
+                {
+                    //! Only the malformed candle is skipped, the rest of the range is still merged
+                    spdlog::error("invalid ohlc candle for {}-{} [{}]: {}", base, quote, range, error.what());
+                    continue;
+                }
+
+                if (candles.empty() || candle.timestamp > candles.back().timestamp)
+                {
+                    candles.emplace_back(candle);
+                }
+                else if (candle.timestamp == candles.back().timestamp)
+                {
+                    //! The last candle was still open when we cached it
+                    candles.back()  = candle;
+                    first_dirty_idx = std::min(first_dirty_idx, candles.size() - 1);
+                }
+            }
+
+            if (candles.size() > m_max_candles_per_range + m_max_candles_per_range / 4)
+            {
+                //! Compaction, keep only the most recent candles
+                candles.erase(begin(candles), end(candles) - m_max_candles_per_range);
+                rewrite_range(path, candles);
+            }
+            else if (nb_cached == 0)
+            {
+                rewrite_range(path, candles);
+            }
+            else if (first_dirty_idx < candles.size())
+            {
+                std::fstream ofs(path.string(), std::ios::binary | std::ios::in | std::ios::out);
+                ofs.seekp(g_ohlc_cache_header_size + first_dirty_idx * sizeof(ohlc_candle));
+                ofs.write(reinterpret_cast<const char*>(candles.data() + first_dirty_idx), (candles.size() - first_dirty_idx) * sizeof(ohlc_candle));
+                if (not ofs.good())
+                {
+                    spdlog::error("cannot append to ohlc cache file: {}", path.string());
+                }
+            }
+            out[range] = candles;
+        }
+        return out;
+    }
+
+    void
+    ohlc_candles_cache::compact(const std::string& base, const std::string& quote, const std::string& range) noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        std::scoped_lock lock(m_cache_mutex);
+        const auto       path    = get_range_path(base, quote, range);
+        auto             candles = read_range(path);
+        if (candles.size() > m_max_candles_per_range)
+        {
+            candles.erase(begin(candles), end(candles) - m_max_candles_per_range);
+            rewrite_range(path, candles);
+        }
+    }
+
+    void
+    ohlc_candles_cache::clear(const std::string& base, const std::string& quote) noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        std::scoped_lock lock(m_cache_mutex);
+        const auto       prefix = base + "-" + quote + ".";
+
+        boost::system::error_code ec;
+        std::vector<fs::path>     to_remove;
+        for (fs::directory_iterator it(m_cache_folder, ec), end; not ec && it != end; it.increment(ec))
+        {
+            if (it->path().extension() == g_ohlc_cache_extension && boost::algorithm::starts_with(it->path().filename().string(), prefix))
+            {
+                to_remove.push_back(it->path());
+            }
+        }
+        for (auto&& path: to_remove) { fs::remove(path, ec); }
+    }
+} // namespace atomic_dex
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include "atomic.dex.pch.hpp"
+
+namespace atomic_dex
+{
+    //! On disk representation of one candle, records are appended in timestamp order
+    struct ohlc_candle
+    {
+        std::uint64_t timestamp;
+        double        open;
+        double        high;
+        double        low;
+        double        close;
+        double        volume;
+        double        quote_volume;
+    };
+
+    static_assert(sizeof(ohlc_candle) == 56, "ohlc_candle must stay a packed 56 bytes record");
+
+    void to_json(nlohmann::json& j, const ohlc_candle& candle);
+    void from_json(const nlohmann::json& j, ohlc_candle& candle);
+
+    //! Local candle database, one append-only file per pair and per range: <data_folder>/ohlc/<base>-<quote>.<range>.ohlc
+    class ohlc_candles_cache
+    {
+        using t_candles = std::vector<ohlc_candle>;
+
+        fs::path    m_cache_folder;
+        std::size_t m_max_candles_per_range;
+        std::mutex  m_cache_mutex;
+
+        //! Private API
+        fs::path  get_range_path(const std::string& base, const std::string& quote, const std::string& range) const noexcept;
+        t_candles read_range(const fs::path& path) const noexcept;
+        void      rewrite_range(const fs::path& path, const t_candles& candles) const noexcept;
+
+      public:
+        //! Constructor
+        explicit ohlc_candles_cache(fs::path cache_folder, std::size_t max_candles_per_range = 5000);
+
+        //! Return all the cached ranges of a pair with the same layout as the raw ohlc answer, empty object if nothing is cached
+        nlohmann::json load(const std::string& base, const std::string& quote) noexcept;
+
+        //! Append the candles newer than the cached tail (the last candle is overwritten if still open), return the merged ranges
+        nlohmann::json merge(const std::string& base, const std::string& quote, const nlohmann::json& raw_ohlc) noexcept;
+
+        //! Keep only the last max_candles_per_range candles of a range
+        void compact(const std::string& base, const std::string& quote, const std::string& range) noexcept;
+
+        //! Remove every cached range of a pair
+        void clear(const std::string& base, const std::string& quote) noexcept;
+    };
+} // namespace atomic_dex
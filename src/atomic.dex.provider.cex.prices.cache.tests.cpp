@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.provider.cex.prices.cache.hpp"
+#include <doctest/doctest.h>
+
+SCENARIO("atomic dex ohlc candles cache")
+{
+    GIVEN("An empty cache folder")
+    {
+        const fs::path cache_folder = fs::temp_directory_path() / fs::unique_path();
+        fs::create_directories(cache_folder);
+        atomic_dex::ohlc_candles_cache cache(cache_folder, 4);
+
+        CHECK(cache.load("kmd", "btc").empty());
+
+        WHEN("I merge a first answer")
+        {
+            auto j = R"(
+              {
+               "60":[{"timestamp":60,"open":1.0,"high":2.0,"low":0.5,"close":1.5,"volume":10.0,"quote_volume":15.0},
+                     {"timestamp":120,"open":1.5,"high":2.0,"low":1.0,"close":1.8,"volume":5.0,"quote_volume":9.0}]
+              }
+            )"_json;
+            auto merged = cache.merge("kmd", "btc", j);
+            CHECK_EQ(merged.at("60").size(), 2);
+
+            THEN("the candles are available from disk")
+            {
+                auto loaded = cache.load("kmd", "btc");
+                CHECK_EQ(loaded.at("60").size(), 2);
+                CHECK_EQ(loaded.at("60").back().at("close").get<double>(), doctest::Approx(1.8));
+            }
+
+            AND_WHEN("I merge an overlapping answer")
+            {
+                auto tail = R"(
+                  {
+                   "60":[{"timestamp":120,"open":1.5,"high":2.2,"low":1.0,"close":2.1,"volume":6.0,"quote_volume":12.0},
+                         {"timestamp":180,"open":2.1,"high":2.3,"low":2.0,"close":2.2,"volume":1.0,"quote_volume":2.2}]
+                  }
+                )"_json;
+                cache.merge("kmd", "btc", tail);
+
+                THEN("only the tail is appended and the open candle is updated")
+                {
+                    auto loaded = cache.load("kmd", "btc");
+                    CHECK_EQ(loaded.at("60").size(), 3);
+                    CHECK_EQ(loaded.at("60").at(1).at("close").get<double>(), doctest::Approx(2.1));
+                    CHECK_EQ(loaded.at("60").back().at("timestamp").get<std::size_t>(), 180);
+                }
+
+                AND_THEN("clearing the pair removes every range")
+                {
+                    cache.clear("kmd", "btc");
+                    CHECK(cache.load("kmd", "btc").empty());
+                }
+            }
+
+            AND_WHEN("a malformed candle is in the middle of an answer")
+            {
+                auto tail = R"(
+                  {
+                   "60":[{"timestamp":180,"open":"bad"},
+                         {"timestamp":240,"open":2.1,"high":2.3,"low":2.0,"close":2.2,"volume":1.0,"quote_volume":2.2}]
+                  }
+                )"_json;
+                cache.merge("kmd", "btc", tail);
+
+                THEN("only the malformed candle is skipped")
+                {
+                    auto loaded = cache.load("kmd", "btc");
+                    CHECK_EQ(loaded.at("60").size(), 3);
+                    CHECK_EQ(loaded.at("60").back().at("timestamp").get<std::size_t>(), 240);
+                }
+            }
+        }
+
+        WHEN("I merge more candles than the limit")
+        {
+            const auto make_candles = [](std::size_t first, std::size_t last) {
+                nlohmann::json candles = nlohmann::json::array();
+                for (std::size_t timestamp = first; timestamp <= last; timestamp += 60)
+                {
+                    candles.push_back(
+                        {{"timestamp", timestamp}, {"open", 1.0}, {"high", 1.0}, {"low", 1.0}, {"close", 1.0}, {"volume", 1.0}, {"quote_volume", 1.0}});
+                }
+                return nlohmann::json{{"60", candles}};
+            };
+
+            THEN("merging past 1.25 times the limit keeps only the most recent candles")
+            {
+                auto merged = cache.merge("kmd", "btc", make_candles(60, 360));
+                REQUIRE_EQ(merged.at("60").size(), 4);
+                CHECK_EQ(merged.at("60").front().at("timestamp").get<std::size_t>(), 180);
+                CHECK_EQ(merged.at("60").back().at("timestamp").get<std::size_t>(), 360);
+
+                auto loaded = cache.load("kmd", "btc");
+                REQUIRE_EQ(loaded.at("60").size(), 4);
+                CHECK_EQ(loaded.at("60").front().at("timestamp").get<std::size_t>(), 180);
+            }
+
+            AND_THEN("an explicit compaction trims a range under the merge threshold")
+            {
+                cache.merge("kmd", "btc", make_candles(60, 300));
+                CHECK_EQ(cache.load("kmd", "btc").at("60").size(), 5);
+                cache.compact("kmd", "btc", "60");
+                auto loaded = cache.load("kmd", "btc");
+                REQUIRE_EQ(loaded.at("60").size(), 4);
+                CHECK_EQ(loaded.at("60").front().at("timestamp").get<std::size_t>(), 120);
+                CHECK_EQ(loaded.at("60").back().at("timestamp").get<std::size_t>(), 300);
+            }
+        }
+        fs::remove_all(cache_folder);
+    }
+}
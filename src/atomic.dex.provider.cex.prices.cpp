@@ -19,12 +19,160 @@
 #include "atomic.dex.provider.cex.prices.api.hpp"
 #include "atomic.threadpool.hpp"
 
+namespace
+{
+    //! Used until the provider tickers list has been fetched at least once
+    const std::array<const char*, 40> g_default_supported_pairs{
+        "eth-btc",  "eth-usdc", "btc-usdc", "btc-busd", "btc-tusd", "bat-btc",  "bat-eth",  "bat-usdc", "bat-tusd", "bat-busd",
+        "bch-btc",  "bch-eth",  "bch-usdc", "bch-tusd", "bch-busd", "dash-btc", "dash-eth", "dgb-btc",  "doge-btc", "kmd-btc",
+        "kmd-eth",  "ltc-btc",  "ltc-eth",  "ltc-usdc", "ltc-tusd", "ltc-busd", "nav-btc",  "nav-eth",  "pax-btc",  "pax-eth",
+        "qtum-btc", "qtum-eth", "rvn-btc",  "xzc-btc",  "xzc-eth",  "zec-btc",  "zec-eth",  "zec-usdc", "zec-tusd", "zec-busd"};
+
+    fs::path
+    get_supported_pairs_cache_path()
+    {
+        return get_atomic_dex_ohlc_cache_folder() / "tickers_list.json";
+    }
+
+    std::uint32_t
+    make_pair_key(atomic_dex::t_ticker_id base_id, atomic_dex::t_ticker_id rel_id) noexcept
+    {
+        return (static_cast<std::uint32_t>(base_id) << 16u) | rel_id;
+    }
+
+    atomic_dex::t_ticker_id
+    find_ticker_id(const std::string& ticker) noexcept
+    {
+        const auto& interner = atomic_dex::get_ticker_interner();
+        if (const auto id = interner.find(ticker); id != atomic_dex::g_invalid_ticker_id)
+        {
+            return id;
+        }
+        return interner.find(boost::algorithm::to_upper_copy(ticker));
+    }
+} // namespace
+
+namespace atomic_dex
+{
+    void
+    ohlc_supported_pairs::insert(const std::string& pair)
+    {
+        const auto& interner  = get_ticker_interner();
+        bool        all_known = true;
+
+        //! A ticker may contain a dash too, every split is registered as the joined name used to be matched as a whole
+        for (auto separator = pair.find('-'); separator != std::string::npos; separator = pair.find('-', separator + 1))
+        {
+            const auto base_id = interner.find(boost::algorithm::to_upper_copy(pair.substr(0, separator)));
+            const auto rel_id  = interner.find(boost::algorithm::to_upper_copy(pair.substr(separator + 1)));
+            if (base_id != g_invalid_ticker_id && rel_id != g_invalid_ticker_id)
+            {
+                m_ids.insert(make_pair_key(base_id, rel_id));
+            }
+            else
+            {
+                all_known = false;
+            }
+        }
+
+        //! Tickers missing from the wallet stay plain strings, a provider list must not use up the ticker ids
+        if (not all_known)
+        {
+            m_unknown_pairs.insert(boost::algorithm::to_lower_copy(pair));
+        }
+    }
+
+    bool
+    ohlc_supported_pairs::contains(const std::string& base, const std::string& rel) const noexcept
+    {
+        const auto base_id = find_ticker_id(base);
+        const auto rel_id  = find_ticker_id(rel);
+        if (base_id != g_invalid_ticker_id && rel_id != g_invalid_ticker_id && m_ids.count(make_pair_key(base_id, rel_id)) > 0)
+        {
+            return true;
+        }
+        return m_unknown_pairs.count(boost::algorithm::to_lower_copy(base + "-" + rel)) > 0;
+    }
+
+    bool
+    ohlc_supported_pairs::empty() const noexcept
+    {
+        return m_ids.empty() && m_unknown_pairs.empty();
+    }
+
+    std::size_t
+    ohlc_supported_pairs::size() const noexcept
+    {
+        return m_ids.size() + m_unknown_pairs.size();
+    }
+
+    ohlc_candle_view::ohlc_candle_view(const nlohmann::json& candle, bool quoted) noexcept : m_candle(candle), m_quoted(quoted)
+    {
+    }
+
+    std::uint64_t
+    ohlc_candle_view::timestamp() const
+    {
+        return m_candle.at("timestamp").get<std::uint64_t>();
+    }
+
+    double
+    ohlc_candle_view::open() const
+    {
+        return m_quoted ? 1 / m_candle.at("open").get<double>() : m_candle.at("open").get<double>();
+    }
+
+    double
+    ohlc_candle_view::high() const
+    {
+        //! The highest price of the inverted pair is the inverse of the lowest one
+        return m_quoted ? 1 / m_candle.at("low").get<double>() : m_candle.at("high").get<double>();
+    }
+
+    double
+    ohlc_candle_view::low() const
+    {
+        return m_quoted ? 1 / m_candle.at("high").get<double>() : m_candle.at("low").get<double>();
+    }
+
+    double
+    ohlc_candle_view::close() const
+    {
+        return m_quoted ? 1 / m_candle.at("close").get<double>() : m_candle.at("close").get<double>();
+    }
+
+    double
+    ohlc_candle_view::volume() const
+    {
+        return m_quoted ? m_candle.at("quote_volume").get<double>() : m_candle.at("volume").get<double>();
+    }
+
+    double
+    ohlc_candle_view::quote_volume() const
+    {
+        return m_quoted ? m_candle.at("volume").get<double>() : m_candle.at("quote_volume").get<double>();
+    }
+
+    void
+    to_json(nlohmann::json& j, const ohlc_candle_view& candle)
+    {
+        j["timestamp"]    = candle.timestamp();
+        j["open"]         = candle.open();
+        j["high"]         = candle.high();
+        j["low"]          = candle.low();
+        j["close"]        = candle.close();
+        j["volume"]       = candle.volume();
+        j["quote_volume"] = candle.quote_volume();
+    }
+} // namespace atomic_dex
+
 namespace atomic_dex
 {
     cex_prices_provider::cex_prices_provider(entt::registry& registry, mm2& mm2_instance) : system(registry), m_mm2_instance(mm2_instance)
     {
         spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
         disable();
+        load_supported_pairs();
         dispatcher_.sink<mm2_started>().connect<&cex_prices_provider::on_mm2_started>(*this);
         dispatcher_.sink<orderbook_refresh>().connect<&cex_prices_provider::on_current_orderbook_ticker_pair_changed>(*this);
     }
@@ -57,8 +205,10 @@ namespace atomic_dex
     {
         spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
 
-        if (auto [normal, quoted] = is_pair_supported(evt.base, evt.rel); !normal && !quoted)
+        auto [normal, quoted] = is_pair_supported(evt.base, evt.rel);
+        if (!normal && !quoted)
         {
+            ++m_current_pair_generation;
             m_current_ohlc_data->clear();
             m_current_orderbook_ticker_pair.first  = "";
             m_current_orderbook_ticker_pair.second = "";
@@ -66,11 +216,42 @@ namespace atomic_dex
             return;
         }
 
+        t_current_orderbook_ticker_pair new_pair{boost::algorithm::to_lower_copy(evt.base), boost::algorithm::to_lower_copy(evt.rel)};
+        if (not m_current_ohlc_data->empty() && m_current_orderbook_ticker_pair == t_current_orderbook_ticker_pair{new_pair.second, new_pair.first})
+        {
+            //! Market pair swapped, same underlying candles, only the view changes
+            spdlog::debug("orderbook pair swapped for cex provider [{} / {}]", new_pair.first, new_pair.second);
+            m_current_orderbook_ticker_pair = std::move(new_pair);
+            m_current_pair_quoted           = quoted;
+            this->dispatcher_.trigger<refresh_ohlc_needed>(true);
+            return;
+        }
+
         m_current_ohlc_data             = nlohmann::json::array();
-        m_current_orderbook_ticker_pair = {boost::algorithm::to_lower_copy(evt.base), boost::algorithm::to_lower_copy(evt.rel)};
+        m_current_orderbook_ticker_pair = std::move(new_pair);
+        m_current_pair_quoted           = quoted;
         auto [base, rel]                = m_current_orderbook_ticker_pair;
+        const auto generation           = ++m_current_pair_generation;
         spdlog::debug("new orderbook pair for cex provider [{} / {}]", base, rel);
-        m_pending_tasks.push(spawn([base = base, rel = rel, this]() { process_ohlc(base, rel, true); }));
+
+        //! The cache is read from the fetch task, the dispatcher thread never waits on the disk
+        m_pending_tasks.push(spawn([base = base, rel = rel, quoted = quoted, generation, this]() {
+            //! Render the cached candles right away, the fetch will only have to bring the missing tail
+            bool is_a_reset = true;
+            if (auto cached = quoted ? m_ohlc_cache.load(rel, base) : m_ohlc_cache.load(base, rel); not cached.empty())
+            {
+                if (generation != m_current_pair_generation)
+                {
+                    spdlog::debug("{} / {} is no longer the current pair, dropping its cached candles", base, rel);
+                    return;
+                }
+                spdlog::debug("{} / {} loaded from the ohlc cache", base, rel);
+                m_current_ohlc_data = std::move(cached);
+                this->dispatcher_.trigger<refresh_ohlc_needed>(true);
+                is_a_reset = false;
+            }
+            process_ohlc(base, rel, is_a_reset);
+        }));
     }
 
     void
@@ -83,6 +264,7 @@ namespace atomic_dex
             spdlog::info("cex prices provider thread started");
 
             using namespace std::chrono_literals;
+            fetch_supported_pairs();
             do
             {
                 spdlog::info("fetching ohlc value");
@@ -114,11 +296,11 @@ namespace atomic_dex
                 req.base_asset  = rel;
                 req.quote_asset = base;
             }
-            auto answer = atomic_dex::rpc_ohlc_get_data(std::move(req));
+            const auto [cache_base, cache_quote] = req;
+            auto answer                          = atomic_dex::rpc_ohlc_get_data(std::move(req));
             if (answer.result.has_value())
             {
-                m_current_ohlc_data = answer.result.value().raw_result;
-                this->updating_quote_and_average(quoted);
+                m_current_ohlc_data = m_ohlc_cache.merge(cache_base, cache_quote, answer.result.value().raw_result);
                 this->dispatcher_.trigger<refresh_ohlc_needed>(is_a_reset);
                 return true;
             }
@@ -133,12 +315,81 @@ namespace atomic_dex
     std::pair<bool, bool>
     cex_prices_provider::is_pair_supported(const std::string& base, const std::string& rel) const noexcept
     {
-        std::pair<bool, bool> result;
-        const std::string     tickers = boost::algorithm::to_lower_copy(base) + "-" + boost::algorithm::to_lower_copy(rel);
-        result.first                  = std::any_of(begin(m_supported_pair), end(m_supported_pair), [tickers](auto&& cur_str) { return cur_str == tickers; });
-        const std::string quoted_tickers = boost::algorithm::to_lower_copy(rel) + "-" + boost::algorithm::to_lower_copy(base);
-        result.second = std::any_of(begin(m_supported_pair), end(m_supported_pair), [quoted_tickers](auto&& cur_str) { return cur_str == quoted_tickers; });
-        return result;
+        std::shared_lock lock(m_supported_pairs_mutex);
+        return {m_supported_pairs.contains(base, rel), m_supported_pairs.contains(rel, base)};
+    }
+
+    void
+    cex_prices_provider::load_supported_pairs() noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        t_supported_pairs pairs;
+        if (std::ifstream ifs(get_supported_pairs_cache_path().string()); ifs.is_open())
+        {
+            try
+            {
+                nlohmann::json           j = nlohmann::json::parse(ifs);
+                ohlc_tickers_list_answer answer;
+                from_json(j, answer);
+                if (answer.result.has_value())
+                {
+                    for (auto&& pair: answer.result.value()) { pairs.insert(pair); }
+                }
+            }
+            catch (const std::exception& error)
+            {
+                spdlog::warn("cannot read the cached tickers list: {}", error.what());
+            }
+        }
+
+        if (pairs.empty())
+        {
+            for (auto&& pair: g_default_supported_pairs) { pairs.insert(pair); }
+        }
+        spdlog::info("{} ohlc pairs supported", pairs.size());
+        std::unique_lock lock(m_supported_pairs_mutex);
+        m_supported_pairs = std::move(pairs);
+    }
+
+    void
+    cex_prices_provider::fetch_supported_pairs() noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        auto answer = rpc_ohlc_get_tickers_list();
+        if (not answer.result.has_value() || answer.result.value().empty())
+        {
+            spdlog::warn("cannot fetch the ohlc tickers list, keeping the current one: {}", answer.error.value_or("empty answer"));
+            return;
+        }
+
+        const auto&    tickers    = answer.result.value();
+        const fs::path cache_path = get_supported_pairs_cache_path();
+        const fs::path tmp_path   = fs::path(cache_path).replace_extension(".tmp");
+        {
+            std::ofstream ofs(tmp_path.string(), std::ios::trunc);
+            if (ofs.is_open())
+            {
+                ofs << nlohmann::json(tickers);
+            }
+        }
+
+        boost::system::error_code ec;
+        fs::rename(tmp_path, cache_path, ec);
+        if (ec)
+        {
+            spdlog::error("error: {}", ec.message());
+            fs::remove(tmp_path, ec);
+        }
+
+        t_supported_pairs pairs;
+        for (auto&& pair: tickers) { pairs.insert(pair); }
+        {
+            std::unique_lock lock(m_supported_pairs_mutex);
+            m_supported_pairs = std::move(pairs);
+        }
+        spdlog::info("{} ohlc pairs supported", tickers.size());
     }
 
     bool
@@ -154,13 +405,16 @@ namespace atomic_dex
     cex_prices_provider::get_ohlc_data(const std::string& range) noexcept
     {
         nlohmann::json res = nlohmann::json::array();
-        if (m_current_ohlc_data->contains(range))
-        {
-            res = m_current_ohlc_data->at(range);
-        }
+        for_each_ohlc_candle(range, [&res](const ohlc_candle_view& candle) { res.push_back(candle); });
         return res;
     }
 
+    bool
+    cex_prices_provider::is_current_pair_quoted() const noexcept
+    {
+        return m_current_pair_quoted;
+    }
+
     void
     cex_prices_provider::consume_pending_tasks()
     {
@@ -175,70 +429,17 @@ namespace atomic_dex
         }
     }
 
-    void
-    cex_prices_provider::reverse_ohlc_data(nlohmann::json& cur_range) noexcept
-    {
-        cur_range["open"]         = 1 / cur_range.at("open").get<double>();
-        cur_range["high"]         = 1 / cur_range.at("high").get<double>();
-        cur_range["low"]          = 1 / cur_range.at("low").get<double>();
-        cur_range["close"]        = 1 / cur_range.at("close").get<double>();
-        auto volume               = cur_range.at("volume").get<double>();
-        cur_range["volume"]       = cur_range["quote_volume"];
-        cur_range["quote_volume"] = volume;
-    }
-
     nlohmann::json
     cex_prices_provider::get_all_ohlc_data() noexcept
     {
-        return *m_current_ohlc_data;
-    }
-
-    void
-    cex_prices_provider::updating_quote_and_average(bool is_quoted)
-    {
-        nlohmann::json ohlc_data                  = *this->m_current_ohlc_data;
-        auto           add_moving_average_functor = [](nlohmann::json& current_item, std::size_t idx, const std::vector<double>& sums, std::size_t num) {
-            int real_num  = num;
-            int first_idx = static_cast<int>(idx) - real_num;
-            if (first_idx < 0)
-            {
-                first_idx = 0;
-                num       = idx;
-            }
-
-            if (num == 0)
-            {
-                current_item["ma_" + std::to_string(real_num)] = current_item.at("open").get<double>();
-            }
-            else
-            {
-                current_item["ma_" + std::to_string(real_num)] = static_cast<double>(sums.at(idx) - sums.at(first_idx)) / num;
-            }
-        };
-
-        for (auto&& [key, value]: ohlc_data.items())
+        nlohmann::json res       = nlohmann::json::object();
+        auto           ohlc_data = m_current_ohlc_data.synchronize();
+        const bool     quoted    = m_current_pair_quoted;
+        for (auto&& [range, candles]: ohlc_data->items())
         {
-            std::size_t         idx = 0;
-            std::vector<double> sums;
-            for (auto&& cur_range: value)
-            {
-                if (is_quoted)
-                {
-                    this->reverse_ohlc_data(cur_range);
-                }
-                if (idx == 0)
-                {
-                    sums.emplace_back(cur_range.at("open").get<double>());
-                }
-                else
-                {
-                    sums.emplace_back(cur_range.at("open").get<double>() + sums[idx - 1]);
-                }
-                add_moving_average_functor(cur_range, idx, sums, 20);
-                add_moving_average_functor(cur_range, idx, sums, 50);
-                ++idx;
-            }
+            auto& out = res[range] = nlohmann::json::array();
+            for (auto&& candle: candles) { out.push_back(ohlc_candle_view{candle, quoted}); }
         }
-        this->m_current_ohlc_data = ohlc_data;
+        return res;
     }
 } // namespace atomic_dex
\ No newline at end of file
@@ -21,8 +21,8 @@
 //! Project header
 #include "atomic.dex.ma.series.data.hpp"
 #include "atomic.dex.mm2.hpp"
-
-inline constexpr const std::size_t nb_pair_supported = 40_sz;
+#include "atomic.dex.provider.cex.prices.cache.hpp"
+#include "atomic.dex.ticker.interner.hpp"
 
 namespace atomic_dex
 {
@@ -34,9 +34,46 @@ namespace atomic_dex
 
     namespace ag = antara::gaming;
 
+    //! Read-only adaptor over a raw candle, a quoted pair is inverted on the fly instead of rewriting the stored series
+    class ohlc_candle_view
+    {
+        const nlohmann::json& m_candle;
+        bool                  m_quoted;
+
+      public:
+        ohlc_candle_view(const nlohmann::json& candle, bool quoted) noexcept;
+
+        [[nodiscard]] std::uint64_t timestamp() const;
+        [[nodiscard]] double        open() const;
+        [[nodiscard]] double        high() const;
+        [[nodiscard]] double        low() const;
+        [[nodiscard]] double        close() const;
+        [[nodiscard]] double        volume() const;
+        [[nodiscard]] double        quote_volume() const;
+    };
+
+    void to_json(nlohmann::json& j, const ohlc_candle_view& candle);
+
+    //! Pairs listed by the ohlc provider, the provider tickers are never added to the process wide interner
+    class ohlc_supported_pairs
+    {
+        std::unordered_set<std::uint32_t> m_ids;           ///< (base id << 16) | rel id, both tickers already interned
+        std::unordered_set<std::string>   m_unknown_pairs; ///< lowercase "base-rel" of the pairs with a ticker unknown at insertion
+
+      public:
+        //! A lowercase "base-rel" pair of the provider
+        void insert(const std::string& pair);
+
+        //! Case insensitive, base then rel
+        [[nodiscard]] bool contains(const std::string& base, const std::string& rel) const noexcept;
+
+        [[nodiscard]] bool        empty() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+    };
+
     class cex_prices_provider final : public ag::ecs::pre_update_system<cex_prices_provider>
     {
-        using t_supported_pairs               = std::array<std::string, nb_pair_supported>;
+        using t_supported_pairs               = ohlc_supported_pairs;
         using t_current_orderbook_ticker_pair = std::pair<std::string, std::string>;
         using t_synchronized_json             = boost::synchronized_value<nlohmann::json>;
 
@@ -45,14 +82,14 @@ namespace atomic_dex
 
         //! OHLC Related
         t_current_orderbook_ticker_pair m_current_orderbook_ticker_pair{"", ""};
-        t_supported_pairs               m_supported_pair{"eth-btc",  "eth-usdc", "btc-usdc", "btc-busd", "btc-tusd", "bat-btc",  "bat-eth",  "bat-usdc",
-                                           "bat-tusd", "bat-busd", "bch-btc",  "bch-eth",  "bch-usdc", "bch-tusd", "bch-busd", "dash-btc",
-                                           "dash-eth", "dgb-btc",  "doge-btc", "kmd-btc",  "kmd-eth",  "ltc-btc",  "ltc-eth",  "ltc-usdc",
-                                           "ltc-tusd", "ltc-busd", "nav-btc",  "nav-eth",  "pax-btc",  "pax-eth",  "qtum-btc", "qtum-eth",
-                                           "rvn-btc",  "xzc-btc",  "xzc-eth",  "zec-btc",  "zec-eth",  "zec-usdc", "zec-tusd", "zec-busd"};
+        mutable folly::SharedMutex      m_supported_pairs_mutex;
+        t_supported_pairs               m_supported_pairs;
 
-        //! OHLC Data
+        //! OHLC Data, stored as fetched from the provider, see ohlc_candle_view
         t_synchronized_json        m_current_ohlc_data;
+        std::atomic_bool           m_current_pair_quoted{false};
+        std::atomic_uint64_t       m_current_pair_generation{0}; ///< bumped on every pair change, a late cache load of an old pair is dropped
+        ohlc_candles_cache         m_ohlc_cache{get_atomic_dex_ohlc_cache_folder()};
 
         //! Threads
         std::queue<std::future<void>> m_pending_tasks;
@@ -60,7 +97,8 @@ namespace atomic_dex
         timed_waiter                  m_provider_thread_timer;
 
         //! Private API
-        void reverse_ohlc_data(nlohmann::json& cur_range) noexcept;
+        void load_supported_pairs() noexcept;
+        void fetch_supported_pairs() noexcept;
 
       public:
         //! Constructor
@@ -91,10 +129,30 @@ namespace atomic_dex
 
         nlohmann::json get_all_ohlc_data() noexcept;
 
+        //! Iterate over the candles of a range without copying them, the functor receive an ohlc_candle_view
+        template <typename Functor>
+        void for_each_ohlc_candle(const std::string& range, Functor&& functor) const;
+
+        //! True if the current pair is the inverse of the pair served by the provider
+        bool is_current_pair_quoted() const noexcept;
+
         //! Event that occur when the ticker pair is changed in the front end
         void on_current_orderbook_ticker_pair_changed(const orderbook_refresh& evt) noexcept;
-        void updating_quote_and_average(bool quoted);
     };
+
+    template <typename Functor>
+    void
+    cex_prices_provider::for_each_ohlc_candle(const std::string& range, Functor&& functor) const
+    {
+        auto       ohlc_data = m_current_ohlc_data.synchronize();
+        const bool quoted    = m_current_pair_quoted;
+        if (not ohlc_data->contains(range))
+        {
+            return;
+        }
+
+        for (auto&& candle: ohlc_data->at(range)) { functor(ohlc_candle_view{candle, quoted}); }
+    }
 } // namespace atomic_dex
 
 REFL_AUTO(type(atomic_dex::cex_prices_provider))
\ No newline at end of file
@@ -26,6 +26,58 @@ TEST_CASE("atomic dex cex prices provider constructor")
     atomic_dex::cex_prices_provider provider(registry, mm2);
 }
 
+TEST_CASE("atomic dex ohlc candle quoted view")
+{
+    auto candle = R"({"timestamp":1593341640,"open":2.0,"high":4.0,"low":1.0,"close":2.0,"volume":10.0,"quote_volume":20.0})"_json;
+
+    atomic_dex::ohlc_candle_view regular{candle, false};
+    CHECK_EQ(regular.high(), doctest::Approx(4.0));
+    CHECK_EQ(regular.volume(), doctest::Approx(10.0));
+
+    atomic_dex::ohlc_candle_view quoted{candle, true};
+    CHECK_EQ(quoted.open(), doctest::Approx(0.5));
+    CHECK_EQ(quoted.high(), doctest::Approx(1.0));
+    CHECK_EQ(quoted.low(), doctest::Approx(0.25));
+    CHECK_EQ(quoted.volume(), doctest::Approx(20.0));
+    CHECK_EQ(quoted.quote_volume(), doctest::Approx(10.0));
+}
+
+TEST_CASE("atomic dex ohlc supported pairs")
+{
+    auto& interner = atomic_dex::get_ticker_interner();
+    interner.intern("KMD");
+    interner.intern("BTC");
+
+    atomic_dex::ohlc_supported_pairs pairs;
+    CHECK(pairs.empty());
+    pairs.insert("kmd-btc");
+    pairs.insert("unittestfoo-usdc");
+    pairs.insert("unittest-erc20-btc");
+
+    SUBCASE("pairs of interned tickers match whatever the case but keep their direction")
+    {
+        CHECK(pairs.contains("KMD", "BTC"));
+        CHECK(pairs.contains("kmd", "btc"));
+        CHECK_FALSE(pairs.contains("BTC", "KMD"));
+        CHECK_FALSE(pairs.contains("KMD", "USDC"));
+    }
+
+    SUBCASE("tickers unknown to the wallet are not interned and still match")
+    {
+        CHECK_EQ(interner.find("UNITTESTFOO"), atomic_dex::g_invalid_ticker_id);
+        CHECK(pairs.contains("UNITTESTFOO", "USDC"));
+        CHECK_FALSE(pairs.contains("USDC", "UNITTESTFOO"));
+    }
+
+    SUBCASE("a ticker interned after the insertion still matches")
+    {
+        interner.intern("UNITTEST-ERC20");
+        CHECK(pairs.contains("UNITTEST-ERC20", "BTC"));
+        CHECK(pairs.contains("unittest-erc20", "btc"));
+    }
+    CHECK_EQ(pairs.size(), 3);
+}
+
 SCENARIO("atomic dex cex price service functionnality")
 {
     spdlog::set_level(spdlog::level::trace);
@@ -52,6 +104,9 @@ SCENARIO("atomic dex cex price service functionnality")
                 {
                     CHECK(cex_system.is_ohlc_data_available());
                     CHECK(cex_system.is_pair_supported("kmd", "btc").first);
+                    CHECK(cex_system.is_pair_supported("KMD", "BTC").first);
+                    CHECK(cex_system.is_pair_supported("BTC", "KMD").second);
+                    CHECK_FALSE(cex_system.is_pair_supported("BTC", "KMD").first);
                     CHECK_FALSE(cex_system.get_ohlc_data("60").empty());
                 }
             }
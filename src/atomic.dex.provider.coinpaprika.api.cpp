@@ -17,71 +17,70 @@
 //! Project Headers
 #include "atomic.dex.provider.coinpaprika.api.hpp"
 #include "atomic.dex.http.code.hpp"
-#include "atomic.dex.utilities.hpp"
-
-namespace
-{
-    //! Constants
-    constexpr const char* g_coinpaprika_endpoint = "https://api.coinpaprika.com/v1/";
-} // namespace
+#include "atomic.dex.http.endpoints.hpp"
 
 namespace atomic_dex
 {
     namespace coinpaprika::api
     {
         void
-        to_json(nlohmann::json& j, const price_converter_request& evt)
+        from_json(const nlohmann::json& j, ticker_quote& evt)
         {
-            spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
-
-            j["base_currency_id"]  = evt.base_currency_id;
-            j["quote_currency_id"] = evt.quote_currency_id;
-            j["amount"]            = 1;
+            //! Only the price is mandatory, the statistics are null for the coins without enough history
+            const auto get_number = [&j](const char* field) {
+                const auto it = j.find(field);
+                return it != j.end() && it->is_number() ? it->get<double>() : 0.0;
+            };
+
+            j.at("price").get_to(evt.price);
+            evt.volume_24h         = get_number("volume_24h");
+            evt.percent_change_24h = get_number("percent_change_24h");
+            evt.percent_change_7d  = get_number("percent_change_7d");
         }
 
         void
-        from_json(const nlohmann::json& j, price_converter_answer& evt)
+        from_json(const nlohmann::json& j, ticker_info_answer& evt)
         {
-            spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
-
-            utils::my_json_sax sx;
-            nlohmann::json::sax_parse(j.dump(), &sx);
-
-            evt.base_currency_id         = j.at("base_currency_id").get<std::string>();
-            evt.base_currency_name       = j.at("base_currency_name").get<std::string>();
-            evt.base_price_last_updated  = j.at("base_price_last_updated").get<std::string>();
-            evt.quote_currency_id        = j.at("quote_currency_id").get<std::string>();
-            evt.quote_currency_name      = j.at("quote_currency_name").get<std::string>();
-            evt.quote_price_last_updated = j.at("quote_price_last_updated").get<std::string>();
-            evt.amount                   = j.at("amount").get<int64_t>();
-            evt.price                    = sx.float_as_string;
-
-            std::replace(evt.price.begin(), evt.price.end(), ',', '.');
+            j.at("quotes").get_to(evt.answer);
         }
 
         void
-        from_json(const nlohmann::json& j, ticker_info_answer& evt)
+        from_json(const nlohmann::json& j, ticker_historical_answer& evt)
         {
-            evt.answer = j.at("quotes");
+            evt.answer = j;
         }
 
         void
-        from_json(const nlohmann::json& j, ticker_historical_answer& evt)
+        from_json(const nlohmann::json& j, tickers_answer& evt)
         {
             evt.answer = j;
         }
 
-        price_converter_answer
-        price_converter(const price_converter_request& request)
+        ticker_info_answer
+        tickers_info(const ticker_infos_request& request, http_request_priority priority)
         {
+            using ranges::views::ints;
+            using ranges::views::zip;
             using namespace std::string_literals;
 
             spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
 
-            auto&& [base_id, quote_id] = request;
-            const auto url  = g_coinpaprika_endpoint + "price-converter?base_currency_id="s + base_id + "&quote_currency_id="s + quote_id + "&amount=1"s;
-            const auto resp = RestClient::get(url);
-            price_converter_answer answer;
+            auto&& [ticker_id, quotes] = request;
+            auto url                   = get_external_endpoints().coinpaprika + "tickers/"s + ticker_id + "?quotes=";
+
+            for (auto&& [cur_quote, idx]: zip(quotes, ints(0u, ranges::unreachable)))
+            {
+                url.append(cur_quote);
+
+                //! Append only if not last element, idx start at 0, if idx + 1 == quotes.size(), we are on the last elemnt, we don't append.
+                if (idx < quotes.size() - 1)
+                {
+                    url.append(",");
+                }
+            }
+
+            const auto         resp = get_http_rate_limiter().get(url, priority);
+            ticker_info_answer answer;
 
             spdlog::info("url: {}", url);
             spdlog::info("{} l{} resp code: {}", __FUNCTION__, __LINE__, resp.code);
@@ -100,6 +99,7 @@ namespace atomic_dex
                 answer.raw_result      = resp.body;
                 return answer;
             }
+
             try
             {
                 const auto json_answer = nlohmann::json::parse(resp.body);
@@ -117,31 +117,16 @@ namespace atomic_dex
             return answer;
         }
 
-        ticker_info_answer
-        tickers_info(const ticker_infos_request& request)
+        tickers_answer
+        tickers(const tickers_request& request, http_request_priority priority)
         {
-            using ranges::views::ints;
-            using ranges::views::zip;
             using namespace std::string_literals;
 
             spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
 
-            auto&& [ticker_id, quotes] = request;
-            auto url                   = g_coinpaprika_endpoint + "tickers/"s + ticker_id + "?quotes=";
-
-            for (auto&& [cur_quote, idx]: zip(quotes, ints(0u, ranges::unreachable)))
-            {
-                url.append(cur_quote);
-
-                //! Append only if not last element, idx start at 0, if idx + 1 == quotes.size(), we are on the last elemnt, we don't append.
-                if (idx < quotes.size() - 1)
-                {
-                    url.append(",");
-                }
-            }
-
-            const auto         resp = RestClient::get(url);
-            ticker_info_answer answer;
+            const auto     url  = get_external_endpoints().coinpaprika + "tickers?quotes="s + boost::algorithm::join(request.ticker_quotes, ",");
+            const auto     resp = get_http_rate_limiter().get(url, priority);
+            tickers_answer answer;
 
             spdlog::info("url: {}", url);
             spdlog::info("{} l{} resp code: {}", __FUNCTION__, __LINE__, resp.code);
@@ -166,7 +151,6 @@ namespace atomic_dex
                 const auto json_answer = nlohmann::json::parse(resp.body);
                 from_json(json_answer, answer);
                 answer.rpc_result_code = resp.code;
-                answer.raw_result      = resp.body;
             }
             catch (const std::exception& error)
             {
@@ -179,16 +163,16 @@ namespace atomic_dex
         }
 
         ticker_historical_answer
-        ticker_historical(const ticker_historical_request& request)
+        ticker_historical(const ticker_historical_request& request, http_request_priority priority)
         {
             using namespace std::string_literals;
 
             spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
 
             auto&& [ticker_id, timestamp, interval] = request;
-            auto url = g_coinpaprika_endpoint + "tickers/"s + ticker_id + "/historical?start="s + std::to_string(timestamp) + "&interval="s + interval;
+            auto url = get_external_endpoints().coinpaprika + "tickers/"s + ticker_id + "/historical?start="s + std::to_string(timestamp) + "&interval="s + interval;
 
-            const auto               resp = RestClient::get(url);
+            const auto               resp = get_http_rate_limiter().get(url, priority);
             ticker_historical_answer answer;
 
             spdlog::info("url: {}", url);
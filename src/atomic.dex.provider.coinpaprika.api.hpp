@@ -18,6 +18,9 @@
 
 #include "atomic.dex.pch.hpp"
 
+//! Project Headers
+#include "atomic.dex.http.rate.limiter.hpp"
+
 namespace atomic_dex
 {
     namespace coinpaprika::api
@@ -42,47 +45,52 @@ namespace atomic_dex
             std::vector<std::string> ticker_quotes;
         };
 
-        struct ticker_info_answer
+        //! Quote of a coin in one currency, decoded once from the coinpaprika answer
+        struct ticker_quote
         {
-            nlohmann::json answer;
-            int            rpc_result_code;
-            std::string    raw_result;
+            double price{0.0};
+            double volume_24h{0.0};
+            double percent_change_24h{0.0};
+            double percent_change_7d{0.0};
         };
 
-        struct price_converter_request
+        using t_ticker_quotes = std::unordered_map<std::string, ticker_quote>;
+
+        struct ticker_info_answer
         {
-            std::string base_currency_id;
-            std::string quote_currency_id;
+            t_ticker_quotes answer;
+            int             rpc_result_code;
+            std::string     raw_result;
         };
 
-        struct price_converter_answer
+        struct tickers_request
         {
-            std::string base_currency_id;
-            std::string base_currency_name;
-            std::string base_price_last_updated;
-            std::string quote_currency_id;
-            std::string quote_currency_name;
-            std::string quote_price_last_updated;
-            std::size_t amount;
-            std::string price; ///< we need trick here
-            int         rpc_result_code;
-            std::string raw_result;
+            std::vector<std::string> ticker_quotes;
         };
 
-        void to_json(nlohmann::json& j, const price_converter_request& evt);
+        struct tickers_answer
+        {
+            nlohmann::json answer; ///< array of every ticker known by coinpaprika with the requested quotes
+            int            rpc_result_code;
+            std::string    raw_result;
+        };
 
-        void from_json(const nlohmann::json& j, price_converter_answer& evt);
+        void from_json(const nlohmann::json& j, ticker_quote& evt);
 
         void from_json(const nlohmann::json& j, ticker_info_answer& evt);
 
         void from_json(const nlohmann::json& j, ticker_historical_answer& evt);
 
-        ticker_historical_answer ticker_historical(const ticker_historical_request& request);
-        ticker_info_answer tickers_info(const ticker_infos_request& request);
-        price_converter_answer price_converter(const price_converter_request& request);
+        void from_json(const nlohmann::json& j, tickers_answer& evt);
+
+        ticker_historical_answer ticker_historical(const ticker_historical_request& request, http_request_priority priority = http_request_priority::normal);
+        ticker_info_answer tickers_info(const ticker_infos_request& request, http_request_priority priority = http_request_priority::normal);
+        tickers_answer tickers(const tickers_request& request, http_request_priority priority = http_request_priority::normal);
     } // namespace coinpaprika::api
 
 
-    using t_ticker_info_answer = coinpaprika::api::ticker_info_answer;
+    using t_ticker_info_answer       = coinpaprika::api::ticker_info_answer;
+    using t_ticker_quote             = coinpaprika::api::ticker_quote;
+    using t_ticker_quotes            = coinpaprika::api::t_ticker_quotes;
     using t_ticker_historical_answer = coinpaprika::api::ticker_historical_answer;
 } // namespace atomic_dex
\ No newline at end of file
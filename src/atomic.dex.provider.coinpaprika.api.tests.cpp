@@ -0,0 +1,41 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.provider.coinpaprika.api.hpp"
+#include <doctest/doctest.h>
+
+TEST_CASE("ticker quotes decoding")
+{
+    using namespace atomic_dex::coinpaprika::api;
+
+    auto j = R"(
+      {"id":"kmd-komodo","quotes":{
+        "USD":{"price":0.61,"volume_24h":1500000.5,"percent_change_24h":-2.35,"percent_change_7d":4.1},
+        "BTC":{"price":0.0000701632,"volume_24h":null,"percent_change_24h":null}}}
+    )"_json;
+
+    const auto answer = j.get<ticker_info_answer>();
+    REQUIRE_EQ(answer.answer.size(), 2);
+    CHECK_EQ(answer.answer.at("USD").price, doctest::Approx(0.61));
+    CHECK_EQ(answer.answer.at("USD").volume_24h, doctest::Approx(1500000.5));
+    CHECK_EQ(answer.answer.at("USD").percent_change_24h, doctest::Approx(-2.35));
+    CHECK_EQ(answer.answer.at("USD").percent_change_7d, doctest::Approx(4.1));
+    CHECK_EQ(answer.answer.at("BTC").price, doctest::Approx(0.0000701632));
+    CHECK_EQ(answer.answer.at("BTC").percent_change_24h, 0.0);
+    CHECK_EQ(answer.answer.at("BTC").percent_change_7d, 0.0);
+
+    CHECK_THROWS(R"({"quotes":{"USD":{"volume_24h":1.0}}})"_json.get<ticker_info_answer>());
+}
@@ -17,6 +17,8 @@
 //! Project Headers
 #include "atomic.dex.provider.coinpaprika.hpp"
 #include "atomic.dex.http.code.hpp"
+#include "atomic.dex.http.endpoints.hpp"
+#include "atomic.dex.startup.tracer.hpp"
 #include "atomic.threadpool.hpp"
 
 namespace
@@ -30,7 +32,7 @@ namespace
     fetch_fiat_rates()
     {
         nlohmann::json resp;
-        auto           answer = RestClient::get("https://api.openrates.io/latest?base=USD");
+        auto           answer = get_http_rate_limiter().get(get_external_endpoints().openrates + "latest?base=USD", http_request_priority::high);
         if (answer.code != 200)
         {
             spdlog::warn("unable to fetch last open rates");
@@ -40,74 +42,35 @@ namespace
         return resp;
     }
 
-    template <typename TAnswer, typename TRequest, typename TFunctorRequest>
-    void
-    retry(TAnswer& answer, const TRequest& request, TFunctorRequest&& functor)
-    {
-        while (answer.rpc_result_code == e_http_code::too_many_requests)
-        {
-            spdlog::warn("too many requests, retrying");
-            std::this_thread::sleep_for(1s);
-            functor(request);
-        }
-    }
+    //! Historical points are 2 hours apart, refreshing them more often than hourly only downloads the same points again
+    constexpr auto g_historical_refresh_interval = std::chrono::hours(1);
 
-    void
-    process_ticker_infos(const atomic_dex::coin_config& current_coin, atomic_dex::coinpaprika_provider::t_ticker_infos_registry& reg)
-    {
-        const ticker_infos_request request{.ticker_currency_id = current_coin.coinpaprika_id, .ticker_quotes = {"USD", "EUR", "BTC"}};
-        auto                       answer = tickers_info(request);
-
-        retry(answer, request, [&answer](const ticker_infos_request& request) { answer = tickers_info(request); });
-        reg.insert_or_assign(current_coin.ticker, answer);
-    }
-
-    void
-    process_ticker_historical(const atomic_dex::coin_config& current_coin, atomic_dex::coinpaprika_provider::t_ticker_historical_registry& reg)
+    //! Return false when the request was rate limited and has to be sent again
+    bool
+    process_ticker_historical(const atomic_dex::coin_config& current_coin, atomic_dex::historical_prices_store& store)
     {
         if (current_coin.coinpaprika_id == "test-coin")
         {
-            return;
+            return true;
         }
-        const ticker_historical_request request{.ticker_currency_id = current_coin.coinpaprika_id, .interval = "2h"};
-        auto                            answer = ticker_historical(request);
-        retry(answer, request, [&answer](const ticker_historical_request& request) { answer = ticker_historical(request); });
-        if (answer.raw_result.find("error") == std::string::npos)
+        ticker_historical_request request{.ticker_currency_id = current_coin.coinpaprika_id, .interval = "2h"};
+        if (const auto last_timestamp = store.get_last_timestamp(current_coin.ticker); last_timestamp.has_value())
         {
-            reg.insert_or_assign(current_coin.ticker, answer);
+            //! Only the points we don't have yet
+            request.timestamp = last_timestamp.value() + 1;
         }
-    }
 
-    template <typename Provider>
-    void
-    process_provider(const atomic_dex::coin_config& current_coin, Provider& rate_providers, const std::string& fiat)
-    {
-        if (current_coin.coinpaprika_id != fiat)
+        const auto answer = ticker_historical(request, http_request_priority::low);
+        if (answer.rpc_result_code == e_http_code::ok && answer.raw_result.find("error") == std::string::npos)
         {
-            const auto                    base = current_coin.coinpaprika_id;
-            const price_converter_request request{.base_currency_id = base, .quote_currency_id = fiat};
-            auto                          answer = price_converter(request);
-
-            retry(answer, request, [&answer](const price_converter_request& request) { answer = price_converter(request); });
-
-            if (answer.raw_result.find("error") == std::string::npos)
-            {
-                if (not answer.price.empty())
-                {
-                    rate_providers.insert_or_assign(current_coin.ticker, answer.price);
-                }
-            }
-            else
-                rate_providers.insert_or_assign(current_coin.ticker, "0.00");
-        }
-        else
-        {
-            rate_providers.insert_or_assign(current_coin.ticker, "1.00");
+            const auto now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            store.append(current_coin.ticker, answer.answer, static_cast<std::uint32_t>(now));
         }
+        return answer.rpc_result_code != e_http_code::too_many_requests;
     }
 
     std::string
-    compute_result(const std::string& amount, const std::string& price, const std::string& currency, atomic_dex::cfg& cfg)
+    compute_result(const std::string& amount, double price, const std::string& currency, atomic_dex::cfg& cfg)
     {
         const t_float_50 amount_f(amount);
         const t_float_50 current_price_f(price);
@@ -151,7 +114,8 @@ namespace atomic_dex
         disable();
         dispatcher_.sink<mm2_started>().connect<&coinpaprika_provider::on_mm2_started>(*this);
         dispatcher_.sink<coin_enabled>().connect<&coinpaprika_provider::on_coin_enabled>(*this);
-        dispatcher_.sink<coin_disabled>().connect<&coinpaprika_provider::on_coin_disabled>(*this);
+        dispatcher_.sink<coins_disabled>().connect<&coinpaprika_provider::on_coins_disabled>(*this);
+        dispatcher_.sink<ticker_balance_updated>().connect<&coinpaprika_provider::on_ticker_balance_updated>(*this);
     }
 
     void
@@ -169,7 +133,8 @@ namespace atomic_dex
         }
         dispatcher_.sink<mm2_started>().disconnect<&coinpaprika_provider::on_mm2_started>(*this);
         dispatcher_.sink<coin_enabled>().disconnect<&coinpaprika_provider::on_coin_enabled>(*this);
-        dispatcher_.sink<coin_disabled>().disconnect<&coinpaprika_provider::on_coin_disabled>(*this);
+        dispatcher_.sink<coins_disabled>().disconnect<&coinpaprika_provider::on_coins_disabled>(*this);
+        dispatcher_.sink<ticker_balance_updated>().disconnect<&coinpaprika_provider::on_ticker_balance_updated>(*this);
     }
 
     void
@@ -181,35 +146,38 @@ namespace atomic_dex
             spdlog::info("paprika thread started");
 
             using namespace std::chrono_literals;
+            std::optional<std::chrono::steady_clock::time_point> last_historical_refresh;
             do {
                 spdlog::info("refreshing rate conversion from coinpaprika");
 
-                t_coins coins = m_mm2_instance.get_enabled_coins();
+                const t_coins_view coins = m_mm2_instance.get_enabled_coins();
 
                 std::vector<std::future<void>> out_fut;
 
-                out_fut.reserve(coins.size() * 6 + 1);
+                out_fut.reserve(coins->size() + 2);
                 out_fut.push_back(spawn([this]() { this->m_other_fiats_rates = fetch_fiat_rates(); }));
-                for (auto&& current_coin: coins)
+                out_fut.push_back(spawn([this, coins]() { this->process_bulk_quotes(*coins); }));
+
+                //! Between two full refreshes, only the rate limited historical requests are sent again
+                const auto now          = std::chrono::steady_clock::now();
+                const bool full_refresh = not last_historical_refresh.has_value() || now - last_historical_refresh.value() >= g_historical_refresh_interval;
+
+                std::unordered_set<std::string> to_retry;
+                std::swap(to_retry, *m_historical_to_retry.synchronize());
+                if (full_refresh)
                 {
-                    if (current_coin.coinpaprika_id == "test-coin")
+                    last_historical_refresh = now;
+                }
+                for (auto&& current_coin: *coins)
+                {
+                    if (current_coin.coinpaprika_id == "test-coin" || (not full_refresh && to_retry.count(current_coin.ticker) == 0))
                     {
                         continue;
                     }
-                    out_fut.push_back(spawn([this, cur_coin = current_coin]() { process_ticker_infos(cur_coin, this->m_ticker_infos_registry); }));
-                    out_fut.push_back(spawn([this, cur_coin = current_coin]() { process_ticker_historical(cur_coin, this->m_ticker_historical_registry); }));
-                    out_fut.push_back(spawn([this, cur_coin = current_coin]() { process_provider(cur_coin, m_usd_rate_providers, "usd-us-dollars"); }));
-                    if (current_coin.ticker != "BTC")
-                    {
-                        out_fut.push_back(spawn([this, cur_coin = current_coin]() { process_provider(cur_coin, m_btc_rate_providers, "btc-bitcoin"); }));
-                    }
-                    if (current_coin.ticker != "KMD")
-                    {
-                        out_fut.push_back(spawn([this, cur_coin = current_coin]() { process_provider(cur_coin, m_kmd_rate_providers, "kmd-komodo"); }));
-                    }
-                    out_fut.push_back(spawn([this, cur_coin = current_coin]() { process_provider(cur_coin, m_eur_rate_providers, "eur-euro"); }));
+                    out_fut.push_back(spawn([this, cur_coin = current_coin]() { process_ticker_historical_or_retry(cur_coin); }));
                 }
                 for (auto&& cur_fut: out_fut) { cur_fut.get(); }
+                rebuild_rates_snapshot();
             } while (not m_provider_thread_timer.wait_for(120s));
         });
     }
@@ -228,7 +196,7 @@ namespace atomic_dex
             return "0.00";
         }
 
-        const auto price = get_rate_conversion(fiat, ticker, ec);
+        const auto price = get_rate(fiat, ticker, ec);
 
         if (ec)
         {
@@ -260,52 +228,31 @@ namespace atomic_dex
         return ss.str() == "0" ? "0.00" : ss.str();
     }
 
-    std::string
-    coinpaprika_provider::get_price_in_fiat_all(const std::string& fiat, std::error_code& ec) const noexcept
+    double
+    coinpaprika_provider::get_portfolio_total(const std::string& fiat, std::error_code& ec) const noexcept
     {
-        t_coins coins = m_mm2_instance.get_enabled_coins();
-        try
+        const double total = m_portfolio_totals.get_total(fiat);
+        if (std::isnan(total))
         {
-            t_float_50        final_price_f = 0;
-            std::string       current_price = "0.00";
-            std::stringstream ss;
-
-            for (auto&& current_coin: coins)
-            {
-                if (current_coin.coinpaprika_id == "test-coin")
-                {
-                    continue;
-                }
-
-                current_price = get_price_in_fiat(fiat, current_coin.ticker, ec, true);
-
-                if (ec)
-                {
-                    spdlog::warn("error when converting {} to {}, err: {}", current_coin.ticker, fiat, ec.message());
-                    ec.clear(); //! Reset
-                    continue;
-                }
-
-                if (not current_price.empty())
-                {
-                    const auto current_price_f = t_float_50(current_price);
-                    final_price_f += current_price_f;
-                }
-            }
-
-            std::size_t default_precision = is_this_currency_a_fiat(m_cfg, fiat) ? 2 : 8;
-            ss.precision(default_precision);
-            ss << std::fixed << final_price_f;
-            std::string result = ss.str();
-            boost::trim_right_if(result, boost::is_any_of("0"));
-            boost::trim_right_if(result, boost::is_any_of("."));
-            return result;
+            ec = dextop_error::invalid_fiat_for_rate_conversion;
+            return 0.0;
         }
-        catch (const std::exception& error)
+        return total;
+    }
+
+    std::string
+    coinpaprika_provider::get_price_in_fiat_all(const std::string& fiat, std::error_code& ec) const noexcept
+    {
+        const double total = get_portfolio_total(fiat, ec);
+        if (ec)
         {
-            spdlog::error("exception caught: {}", error.what());
             return "0.00";
         }
+
+        std::string result = t_float_50(total).str(is_this_currency_a_fiat(m_cfg, fiat) ? 2 : 8, std::ios_base::fixed);
+        boost::trim_right_if(result, boost::is_any_of("0"));
+        boost::trim_right_if(result, boost::is_any_of("."));
+        return result;
     }
 
     std::string
@@ -317,7 +264,7 @@ namespace atomic_dex
             return "0.00";
         }
         const auto amount        = tx.am_i_sender ? tx.my_balance_change.substr(1) : tx.my_balance_change;
-        const auto current_price = get_rate_conversion(currency, ticker, ec);
+        const auto current_price = get_rate(currency, ticker, ec);
         if (ec)
         {
             return "0.00";
@@ -334,7 +281,7 @@ namespace atomic_dex
             return "0.00";
         }
 
-        const auto current_price = get_rate_conversion(currency, ticker, ec);
+        const auto current_price = get_rate(currency, ticker, ec);
 
         if (ec)
         {
@@ -344,72 +291,67 @@ namespace atomic_dex
         return compute_result(amount, current_price, currency, this->m_cfg);
     }
 
-    std::string
-    coinpaprika_provider::get_rate_conversion(const std::string& fiat, const std::string& ticker, std::error_code& ec, bool adjusted) const noexcept
+    std::shared_ptr<const rates_snapshot>
+    coinpaprika_provider::get_rates_snapshot() const noexcept
     {
-        std::string current_price;
+        return std::atomic_load(&m_rates_snapshot);
+    }
 
-        if (fiat == "USD")
+    void
+    coinpaprika_provider::rebuild_rates_snapshot() noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        const std::vector<std::string> currencies(m_supported_fiat_registry.begin(), m_supported_fiat_registry.end());
+        const nlohmann::json           fiat_rates = m_other_fiats_rates.get();
+
+        rates_diff changes;
         {
-            //! Do it as usd;
-            if (m_usd_rate_providers.find(ticker) == m_usd_rate_providers.cend())
-            {
-                ec = dextop_error::unknown_ticker_for_rate_conversion;
-                return "0.00";
-            }
-            current_price = m_usd_rate_providers.at(ticker);
+            //! The quotes lock also serializes the publications, a snapshot can't be replaced by an older one
+            auto coins_quotes = m_coins_quotes.synchronize();
+            auto snapshot     = std::make_shared<const rates_snapshot>(*coins_quotes, currencies, fiat_rates, m_kmd_usd_price.load());
+            changes           = rates_snapshot::diff(*std::atomic_load(&m_rates_snapshot), *snapshot);
+            std::atomic_store(&m_rates_snapshot, snapshot);
+            m_portfolio_totals.set_rates(std::move(snapshot));
         }
-        else if (fiat == "EUR")
+
+        if (not changes.empty())
         {
-            if (m_eur_rate_providers.find(ticker) == m_eur_rate_providers.cend())
-            {
-                ec = dextop_error::unknown_ticker_for_rate_conversion;
-                return "0.00";
-            }
-            current_price = m_eur_rate_providers.at(ticker);
+            this->dispatcher_.trigger<rates_updated>(std::move(changes.tickers), std::move(changes.currencies));
         }
-        else if (fiat == "BTC")
+    }
+
+    double
+    coinpaprika_provider::get_rate(const std::string& fiat, const std::string& ticker, std::error_code& ec) const noexcept
+    {
+        if (fiat == ticker)
         {
-            if (ticker == "BTC")
-            {
-                return "1.00";
-            }
-            if (m_btc_rate_providers.find(ticker) == m_btc_rate_providers.cend())
-            {
-                ec = dextop_error::unknown_ticker_for_rate_conversion;
-                return "0.00";
-            }
-            current_price = m_btc_rate_providers.at(ticker);
+            return 1.0;
         }
-        else if (fiat == "KMD")
+
+        const auto rate = get_rates_snapshot()->get_rate(fiat, ticker);
+        if (not rate.has_value())
         {
-            if (ticker == "KMD")
-            {
-                return "1.00";
-            }
-            if (m_kmd_rate_providers.find(ticker) == m_kmd_rate_providers.cend())
-            {
-                ec = dextop_error::unknown_ticker_for_rate_conversion;
-                return "0.00";
-            }
-            current_price = m_kmd_rate_providers.at(ticker);
+            ec = dextop_error::unknown_ticker_for_rate_conversion;
+            return 0.0;
         }
-        else
+        return rate.value();
+    }
+
+    std::string
+    coinpaprika_provider::get_rate_conversion(const std::string& fiat, const std::string& ticker, std::error_code& ec, bool adjusted) const noexcept
+    {
+        const double rate = get_rate(fiat, ticker, ec);
+        if (ec)
         {
-            if (m_usd_rate_providers.find(ticker) == m_usd_rate_providers.cend())
-            {
-                ec = dextop_error::unknown_ticker_for_rate_conversion;
-                return "0.00";
-            }
-            t_float_50 tmp_current_price = t_float_50(m_usd_rate_providers.at(ticker)) * m_other_fiats_rates->at("rates").at(fiat).get<double>();
-            current_price                = tmp_current_price.str();
+            return "0.00";
         }
 
         if (adjusted)
         {
             std::size_t default_precision = is_this_currency_a_fiat(m_cfg, fiat) ? 2 : 8;
 
-            t_float_50 current_price_f(current_price);
+            const t_float_50 current_price_f(rate);
             if (is_this_currency_a_fiat(m_cfg, fiat))
             {
                 if (current_price_f < 1.0)
@@ -424,7 +366,17 @@ namespace atomic_dex
             }
             return current_price_f.str(default_precision, std::ios::fixed);
         }
-        return current_price;
+        return rate_to_string(rate);
+    }
+
+    void
+    coinpaprika_provider::process_ticker_historical_or_retry(const coin_config& coin) noexcept
+    {
+        if (not process_ticker_historical(coin, m_historical_prices))
+        {
+            spdlog::info("historical prices of {} are rate limited, retrying with the next refresh", coin.ticker);
+            m_historical_to_retry->insert(coin.ticker);
+        }
     }
 
     void
@@ -441,18 +393,16 @@ namespace atomic_dex
         if (config.coinpaprika_id != "test-coin")
         {
             spawn([config, evt, this]() {
-                process_provider(config, m_usd_rate_providers, "usd-us-dollars");
-                process_provider(config, m_eur_rate_providers, "eur-euro");
-                if (evt.ticker != "BTC")
+                startup_span span("coinpaprika " + evt.ticker, "coinpaprika");
+                //! One ticker request gives the USD and BTC quotes of the coin, every fiat rate is derived from the USD one
+                const ticker_infos_request request{.ticker_currency_id = config.coinpaprika_id, .ticker_quotes = {"USD", "BTC"}};
+                const auto                 answer = tickers_info(request, http_request_priority::high);
+                if (answer.rpc_result_code == e_http_code::ok)
                 {
-                    process_provider(config, m_btc_rate_providers, "btc-bitcoin");
+                    process_quotes(config, answer.answer);
+                    rebuild_rates_snapshot();
                 }
-                if (evt.ticker != "KMD")
-                {
-                    process_provider(config, m_kmd_rate_providers, "kmd-komodo");
-                }
-                process_ticker_infos(config, m_ticker_infos_registry);
-                process_ticker_historical(config, m_ticker_historical_registry);
+                process_ticker_historical_or_retry(config);
                 this->dispatcher_.trigger<coin_fully_initialized>(evt.ticker);
             });
         }
@@ -463,57 +413,156 @@ namespace atomic_dex
     }
 
     void
-    coinpaprika_provider::on_coin_disabled(const coin_disabled& evt) noexcept
+    coinpaprika_provider::process_quotes(const coin_config& coin, const t_ticker_quotes& quotes) noexcept
+    {
+        const auto usd_it = quotes.find("USD");
+        if (usd_it == quotes.end())
+        {
+            spdlog::warn("no USD quote for {}", coin.ticker);
+            return;
+        }
+
+        if (coin.coinpaprika_id == "kmd-komodo")
+        {
+            m_kmd_usd_price = usd_it->second.price;
+        }
+
+        coin_quotes cur_quotes{.usd = usd_it->second.price};
+        if (auto it = quotes.find("BTC"); it != quotes.end())
+        {
+            cur_quotes.btc = it->second.price;
+        }
+        m_coins_quotes->insert_or_assign(coin.ticker, cur_quotes);
+        m_ticker_infos_registry.insert_or_assign(coin.ticker, quotes);
+    }
+
+    void
+    coinpaprika_provider::process_bulk_quotes(const t_coins& coins) noexcept
     {
         spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
-        const auto config = m_mm2_instance.get_coin_info(evt.ticker);
 
-        m_usd_rate_providers.erase(config.ticker);
-        m_eur_rate_providers.erase(config.ticker);
-        if (evt.ticker != "BTC")
+        std::unordered_map<std::string, std::vector<const coin_config*>> coins_by_paprika_id;
+        for (auto&& coin: coins)
+        {
+            if (coin.coinpaprika_id != "test-coin")
+            {
+                coins_by_paprika_id[coin.coinpaprika_id].push_back(&coin);
+            }
+        }
+
+        const tickers_request request{.ticker_quotes = {"USD", "BTC"}};
+        const auto            answer = tickers(request);
+        if (answer.rpc_result_code != e_http_code::ok || not answer.answer.is_array())
+        {
+            spdlog::warn("unable to fetch the coinpaprika tickers listing: {}", answer.raw_result);
+            return;
+        }
+
+        //! Every quotes object is decoded once, KMD rates are derived from the USD ones so its price must be known first
+        std::vector<std::pair<const std::vector<const coin_config*>*, t_ticker_quotes>> decoded_quotes;
+        decoded_quotes.reserve(coins_by_paprika_id.size());
+        for (auto&& cur: answer.answer)
         {
-            m_btc_rate_providers.erase(config.ticker);
+            const auto id = cur.value("id", "");
+            const auto it = coins_by_paprika_id.find(id);
+            if ((it == coins_by_paprika_id.end() && id != "kmd-komodo") || not cur.contains("quotes"))
+            {
+                continue;
+            }
+
+            try
+            {
+                auto quotes = cur.at("quotes").get<t_ticker_quotes>();
+                if (auto usd_it = quotes.find("USD"); id == "kmd-komodo" && usd_it != quotes.end())
+                {
+                    m_kmd_usd_price = usd_it->second.price;
+                }
+                if (it != coins_by_paprika_id.end())
+                {
+                    decoded_quotes.emplace_back(&it->second, std::move(quotes));
+                }
+            }
+            catch (const std::exception& error)
+            {
+                spdlog::error("invalid quotes for {}: {}", id, error.what());
+            }
         }
-        if (evt.ticker != "KMD")
+
+        for (auto&& [cur_coins, quotes]: decoded_quotes)
         {
-            m_kmd_rate_providers.erase(config.ticker);
+            for (auto&& coin: *cur_coins) { process_quotes(*coin, quotes); }
         }
     }
 
-    t_ticker_info_answer
-    coinpaprika_provider::get_ticker_infos(const std::string& ticker) const noexcept
+    void
+    coinpaprika_provider::on_coins_disabled(const coins_disabled& evt) noexcept
     {
-        return m_ticker_infos_registry.find(ticker) != m_ticker_infos_registry.cend() ? m_ticker_infos_registry.at(ticker) : t_ticker_info_answer{};
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        for (auto&& ticker: evt.tickers)
+        {
+            m_portfolio_totals.remove_balance(ticker);
+            m_historical_prices.erase(ticker);
+            m_coins_quotes->erase(ticker);
+        }
+        rebuild_rates_snapshot();
     }
 
-    t_ticker_historical_answer
+    void
+    coinpaprika_provider::on_ticker_balance_updated(const ticker_balance_updated& evt) noexcept
+    {
+        std::error_code ec;
+        const auto      balance = m_mm2_instance.my_balance(evt.ticker, ec);
+        if (ec)
+        {
+            spdlog::warn("my_balance error for {}: {}", evt.ticker, ec.message());
+            return;
+        }
+        m_portfolio_totals.set_balance(evt.ticker, t_float_50(balance).convert_to<double>());
+    }
+
+    std::optional<t_ticker_quote>
+    coinpaprika_provider::get_ticker_quote(const std::string& ticker, const std::string& currency) const noexcept
+    {
+        if (auto it = m_ticker_infos_registry.find(ticker); it != m_ticker_infos_registry.cend())
+        {
+            if (auto quote_it = it->second.find(currency); quote_it != it->second.end())
+            {
+                return quote_it->second;
+            }
+        }
+        return std::nullopt;
+    }
+
+    price_series
     coinpaprika_provider::get_ticker_historical(const std::string& ticker) const noexcept
     {
-        return m_ticker_historical_registry.find(ticker) != m_ticker_historical_registry.cend() ? m_ticker_historical_registry.at(ticker)
-                                                                                                : t_ticker_historical_answer{.answer = nlohmann::json::array()};
+        return m_historical_prices.get_series(ticker);
+    }
+
+    std::vector<float>
+    coinpaprika_provider::get_ticker_sparkline(const std::string& ticker, std::size_t nb_points) const noexcept
+    {
+        return m_historical_prices.get_sparkline(ticker, nb_points);
     }
 
     std::string
     coinpaprika_provider::get_cex_rates(const std::string& base, const std::string& rel, std::error_code& ec) const noexcept
     {
-        std::string base_rate_str = get_rate_conversion("USD", base, ec, false);
-        if (ec)
-        {
-            return "0.00";
-        }
-        std::string rel_rate_str = get_rate_conversion("USD", rel, ec, false);
-        if (ec)
+        const auto   snapshot = get_rates_snapshot();
+        const auto   usd_id   = snapshot->get_currency_id("USD");
+        const double base_rate = snapshot->get_rate(snapshot->get_ticker_id(base), usd_id);
+        const double rel_rate  = snapshot->get_rate(snapshot->get_ticker_id(rel), usd_id);
+        if (std::isnan(base_rate) || std::isnan(rel_rate))
         {
+            ec = dextop_error::unknown_ticker_for_rate_conversion;
             return "0.00";
         }
-        if (base_rate_str == "0.00" || rel_rate_str == "0.00")
+        if (base_rate <= 0.0 || rel_rate <= 0.0)
         {
             //! One of the rate is not available
             return "0.00";
         }
-        t_float_50  base_rate_f(base_rate_str);
-        t_float_50  rel_rate_f(rel_rate_str);
-        t_float_50  result     = base_rate_f / rel_rate_f;
+        t_float_50  result     = t_float_50(base_rate) / rel_rate;
         std::string result_str = result.str(8, std::ios_base::fixed);
         boost::trim_right_if(result_str, boost::is_any_of("0"));
         boost::trim_right_if(result_str, boost::is_any_of("."));
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+//! Project Headers
+#include "atomic.dex.provider.coinpaprika.historical.hpp"
+
+namespace
+{
+    //! eg: 2020-03-01T00:00:00Z
+    std::optional<std::uint32_t>
+    parse_paprika_timestamp(const std::string& timestamp)
+    {
+        std::istringstream in(timestamp);
+        date::sys_seconds  tp;
+        in >> date::parse("%FT%TZ", tp);
+        if (in.fail())
+        {
+            return std::nullopt;
+        }
+        return static_cast<std::uint32_t>(tp.time_since_epoch().count());
+    }
+} // namespace
+
+namespace atomic_dex
+{
+    historical_prices_store::historical_prices_store(std::chrono::seconds window) : m_window_in_seconds(static_cast<std::uint32_t>(window.count()))
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+    }
+
+    std::size_t
+    historical_prices_store::append(const std::string& ticker, const nlohmann::json& historical, std::uint32_t now) noexcept
+    {
+        if (not historical.is_array())
+        {
+            return 0;
+        }
+
+        std::scoped_lock lock(m_series_mutex);
+        auto&            series    = m_series[ticker];
+        std::size_t      nb_points = 0;
+        try
+        {
+            for (auto&& cur: historical)
+            {
+                const auto timestamp = parse_paprika_timestamp(cur.at("timestamp").get<std::string>());
+                if (not timestamp.has_value() || (not series.timestamps.empty() && timestamp.value() <= series.timestamps.back()))
+                {
+                    continue;
+                }
+                series.timestamps.push_back(timestamp.value());
+                series.prices.push_back(cur.at("price").get<float>());
+                series.volumes.push_back(cur.value("volume_24h", 0.0f));
+                ++nb_points;
+            }
+        }
+        catch (const std::exception& error)
+        {
+            spdlog::error("invalid historical point for {}: {}", ticker, error.what());
+        }
+
+        //! Sliding window, the timestamps are sorted so the outdated points are at the front
+        const std::uint32_t oldest  = now > m_window_in_seconds ? now - m_window_in_seconds : 0;
+        const auto          nb_old  = std::lower_bound(begin(series.timestamps), end(series.timestamps), oldest) - begin(series.timestamps);
+        series.timestamps.erase(begin(series.timestamps), begin(series.timestamps) + nb_old);
+        series.prices.erase(begin(series.prices), begin(series.prices) + nb_old);
+        series.volumes.erase(begin(series.volumes), begin(series.volumes) + nb_old);
+        return nb_points;
+    }
+
+    std::optional<std::uint32_t>
+    historical_prices_store::get_last_timestamp(const std::string& ticker) const noexcept
+    {
+        std::scoped_lock lock(m_series_mutex);
+        if (auto it = m_series.find(ticker); it != m_series.end() && not it->second.timestamps.empty())
+        {
+            return it->second.timestamps.back();
+        }
+        return std::nullopt;
+    }
+
+    price_series
+    historical_prices_store::get_series(const std::string& ticker) const noexcept
+    {
+        std::scoped_lock lock(m_series_mutex);
+        auto             it = m_series.find(ticker);
+        return it != m_series.end() ? it->second : price_series{};
+    }
+
+    std::vector<float>
+    historical_prices_store::get_sparkline(const std::string& ticker, std::size_t nb_points) const noexcept
+    {
+        std::scoped_lock lock(m_series_mutex);
+        auto             it = m_series.find(ticker);
+        if (it == m_series.end())
+        {
+            return {};
+        }
+
+        const auto& prices = it->second.prices;
+        if (nb_points == 0 || prices.size() <= nb_points)
+        {
+            return prices;
+        }
+
+        std::vector<float> out;
+        out.reserve(nb_points);
+        for (std::size_t idx = 0; idx < nb_points; ++idx)
+        {
+            const auto first = begin(prices) + idx * prices.size() / nb_points;
+            const auto last  = begin(prices) + (idx + 1) * prices.size() / nb_points;
+            out.push_back(std::accumulate(first, last, 0.0f) / static_cast<float>(last - first));
+        }
+        return out;
+    }
+
+    void
+    historical_prices_store::erase(const std::string& ticker) noexcept
+    {
+        std::scoped_lock lock(m_series_mutex);
+        m_series.erase(ticker);
+    }
+} // namespace atomic_dex
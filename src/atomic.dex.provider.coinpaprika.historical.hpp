@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include "atomic.dex.pch.hpp"
+
+namespace atomic_dex
+{
+    //! 7 days price history of one coin, one column per field
+    struct price_series
+    {
+        std::vector<std::uint32_t> timestamps; ///< seconds since epoch, ascending
+        std::vector<float>         prices;
+        std::vector<float>         volumes;
+    };
+
+    //! Shared store of the coinpaprika historical answers, new points are appended and points older than the window are dropped
+    class historical_prices_store
+    {
+        using t_series_registry = std::unordered_map<std::string, price_series>;
+
+        mutable std::mutex m_series_mutex;
+        t_series_registry  m_series;
+        std::uint32_t      m_window_in_seconds;
+
+      public:
+        //! Constructor
+        explicit historical_prices_store(std::chrono::seconds window = std::chrono::hours(168));
+
+        //! Append the points of a coinpaprika historical answer newer than the last known one, return the number of points appended
+        std::size_t append(const std::string& ticker, const nlohmann::json& historical, std::uint32_t now) noexcept;
+
+        //! Timestamp of the most recent point, used as the start of the next request
+        [[nodiscard]] std::optional<std::uint32_t> get_last_timestamp(const std::string& ticker) const noexcept;
+
+        [[nodiscard]] price_series get_series(const std::string& ticker) const noexcept;
+
+        //! Average prices of nb_points buckets of equal size, the series itself if it is already smaller
+        [[nodiscard]] std::vector<float> get_sparkline(const std::string& ticker, std::size_t nb_points) const noexcept;
+
+        void erase(const std::string& ticker) noexcept;
+    };
+} // namespace atomic_dex
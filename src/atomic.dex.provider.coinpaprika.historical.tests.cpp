@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.provider.coinpaprika.historical.hpp"
+#include <doctest/doctest.h>
+
+SCENARIO("atomic dex historical prices store")
+{
+    //! 2020-03-01T00:00:00Z
+    constexpr std::uint32_t march_first = 1583020800;
+
+    GIVEN("A store with a 2 days window")
+    {
+        atomic_dex::historical_prices_store store(std::chrono::hours(48));
+        CHECK_FALSE(store.get_last_timestamp("KMD").has_value());
+
+        auto j = R"([
+                {"market_cap":69616966,"price":0.5,"timestamp":"2020-03-01T00:00:00Z","volume_24h":695641},
+                {"market_cap":73140722,"price":0.6,"timestamp":"2020-03-02T00:00:00Z","volume_24h":794110},
+                {"market_cap":73591240,"price":0.7,"timestamp":"2020-03-03T00:00:00Z","volume_24h":1141006}
+            ])"_json;
+        CHECK_EQ(store.append("KMD", j, march_first + 2 * 86400), 3);
+        CHECK_EQ(store.get_last_timestamp("KMD").value(), march_first + 2 * 86400);
+
+        WHEN("The same answer is appended one day later")
+        {
+            auto tail = R"([
+                    {"market_cap":73591240,"price":0.7,"timestamp":"2020-03-03T00:00:00Z","volume_24h":1141006},
+                    {"market_cap":76556127,"price":0.8,"timestamp":"2020-03-04T00:00:00Z","volume_24h":1558428}
+                ])"_json;
+            CHECK_EQ(store.append("KMD", tail, march_first + 3 * 86400), 1);
+
+            THEN("Only the new point is kept and the outdated one is dropped")
+            {
+                const auto series = store.get_series("KMD");
+                REQUIRE_EQ(series.prices.size(), 3);
+                CHECK_EQ(series.timestamps.front(), march_first + 86400);
+                CHECK_EQ(series.prices.back(), doctest::Approx(0.8f));
+            }
+
+            AND_THEN("The sparkline averages the points")
+            {
+                const auto sparkline = store.get_sparkline("KMD", 1);
+                REQUIRE_EQ(sparkline.size(), 1);
+                CHECK_EQ(sparkline.front(), doctest::Approx(0.7f));
+                CHECK_EQ(store.get_sparkline("KMD", 10).size(), 3);
+            }
+        }
+    }
+}
@@ -24,6 +24,8 @@
 #include "atomic.dex.events.hpp"
 #include "atomic.dex.mm2.hpp"
 #include "atomic.dex.provider.coinpaprika.api.hpp"
+#include "atomic.dex.provider.coinpaprika.historical.hpp"
+#include "atomic.dex.provider.coinpaprika.rates.hpp"
 
 namespace atomic_dex
 {
@@ -32,30 +34,43 @@ namespace atomic_dex
     class coinpaprika_provider final : public ag::ecs::pre_update_system<coinpaprika_provider>
     {
       public:
-        using t_ticker_infos_registry      = t_concurrent_reg<std::string, t_ticker_info_answer>;
-        using t_ticker_historical_registry = t_concurrent_reg<std::string, t_ticker_historical_answer>;
+        using t_ticker_infos_registry = t_concurrent_reg<std::string, t_ticker_quotes>;
 
       private:
         //! Typedefs
         using t_json_synchronized       = boost::synchronized_value<nlohmann::json>;
-        using t_providers_registry      = t_concurrent_reg<std::string, std::string>;
+        using t_coins_quotes            = boost::synchronized_value<rates_snapshot::t_coins_quotes>;
         using t_supported_fiat_registry = std::unordered_set<std::string>;
+        using t_tickers_synchronized    = boost::synchronized_value<std::unordered_set<std::string>>;
 
         //! Private fields
-        mm2&                         m_mm2_instance;
-        atomic_dex::cfg&             m_cfg;
-        t_json_synchronized          m_other_fiats_rates;
-        t_providers_registry         m_usd_rate_providers{};
-        t_providers_registry         m_eur_rate_providers{};
-        t_providers_registry         m_btc_rate_providers{};
-        t_providers_registry         m_kmd_rate_providers{};
-        t_ticker_infos_registry      m_ticker_infos_registry{};
-        t_ticker_historical_registry m_ticker_historical_registry{};
-        t_supported_fiat_registry    m_supported_fiat_registry{"USD", "EUR", "BTC", "KMD", "GBP", "HKD", "IDR", "ILS", "DKK", "INR", "CHF", "MXN",
+        mm2&                                  m_mm2_instance;
+        atomic_dex::cfg&                      m_cfg;
+        t_json_synchronized                   m_other_fiats_rates;
+        t_coins_quotes                        m_coins_quotes;
+        std::shared_ptr<const rates_snapshot> m_rates_snapshot{std::make_shared<const rates_snapshot>()};
+        portfolio_totals                      m_portfolio_totals;
+        t_ticker_infos_registry               m_ticker_infos_registry{};
+        historical_prices_store               m_historical_prices;
+        t_tickers_synchronized                m_historical_to_retry; ///< rate limited historical requests, sent again with the next refresh
+        t_supported_fiat_registry             m_supported_fiat_registry{"USD", "EUR", "BTC", "KMD", "GBP", "HKD", "IDR", "ILS", "DKK", "INR", "CHF", "MXN",
                                                             "CZK", "SGD", "THB", "HRK", "MYR", "NOK", "CNY", "BGN", "PHP", "PLN", "ZAR", "CAD",
                                                             "ISK", "BRL", "RON", "NZD", "TRY", "JPY", "RUB", "KRW", "AUD", "HUF", "SEK"};
-        std::thread                  m_provider_rates_thread;
-        timed_waiter                 m_provider_thread_timer;
+        std::atomic<double>                   m_kmd_usd_price{0.0};
+        std::thread                           m_provider_rates_thread;
+        timed_waiter                          m_provider_thread_timer;
+
+        //! Store the numeric rates and the per currency quote table of a coin
+        void process_quotes(const coin_config& coin, const t_ticker_quotes& quotes) noexcept;
+
+        //! Refresh the quotes of all the given coins from a single tickers listing
+        void process_bulk_quotes(const t_coins& coins) noexcept;
+
+        //! Build a new rate matrix from the current quotes and fiat rates then publish it
+        void rebuild_rates_snapshot() noexcept;
+
+        //! Fetch the missing historical prices of the coin, a rate limited request is sent again with the next refresh
+        void process_ticker_historical_or_retry(const coin_config& coin) noexcept;
 
       public:
         //! Constructor
@@ -64,6 +79,12 @@ namespace atomic_dex
         //! Destructor
         ~coinpaprika_provider() noexcept final;
 
+        //! Current rate matrix, readers keep it alive as long as they need it
+        [[nodiscard]] std::shared_ptr<const rates_snapshot> get_rates_snapshot() const noexcept;
+
+        //! Numeric rate conversion for the given fiat.
+        double get_rate(const std::string& fiat, const std::string& ticker, std::error_code& ec) const noexcept;
+
         //! Get the rate conversion for the given fiat.
         std::string get_rate_conversion(const std::string& fiat, const std::string& ticker, std::error_code& ec, bool adjusted = false) const noexcept;
 
@@ -73,6 +94,9 @@ namespace atomic_dex
         //! Get the whole balance in the given fiat.
         std::string get_price_in_fiat_all(const std::string& fiat, std::error_code& ec) const noexcept;
 
+        //! Numeric value of the whole balance in the given fiat, maintained on every balance or rate update.
+        double get_portfolio_total(const std::string& fiat, std::error_code& ec) const noexcept;
+
         //! Get the price in currency from a transaction.
         std::string
         get_price_as_currency_from_tx(const std::string& currency, const std::string& ticker, const tx_infos& tx, std::error_code& ec) const noexcept;
@@ -84,11 +108,14 @@ namespace atomic_dex
         //! Get the cex rates base / rel eg: VRSC / KMD = price of usd VRSC / KMD price USD
         std::string get_cex_rates(const std::string& base, const std::string& rel, std::error_code& ec) const noexcept;
 
-        //! Get the ticker informations.
-        t_ticker_info_answer get_ticker_infos(const std::string& ticker) const noexcept;
+        //! Get the decoded quote (price, volume and changes) of the ticker in the given currency.
+        std::optional<t_ticker_quote> get_ticker_quote(const std::string& ticker, const std::string& currency) const noexcept;
 
-        //! Get the ticker informations.
-        t_ticker_historical_answer get_ticker_historical(const std::string& ticker) const noexcept;
+        //! Get the 7 days price history of the ticker.
+        price_series get_ticker_historical(const std::string& ticker) const noexcept;
+
+        //! Get the 7 days prices of the ticker down-sampled to nb_points.
+        std::vector<float> get_ticker_sparkline(const std::string& ticker, std::size_t nb_points) const noexcept;
 
         //! Event that occur when the mm2 process is launched correctly.
         void on_mm2_started(const mm2_started& evt) noexcept;
@@ -96,8 +123,11 @@ namespace atomic_dex
         //! Event that occur when a coin is correctly enabled.
         void on_coin_enabled(const coin_enabled& evt) noexcept;
 
-        //! Event that occur when a coin is correctly disabled.
-        void on_coin_disabled(const coin_disabled& evt) noexcept;
+        //! Event that occur when coins are correctly disabled.
+        void on_coins_disabled(const coins_disabled& evt) noexcept;
+
+        //! Event that occur when the balance of a coin changed.
+        void on_ticker_balance_updated(const ticker_balance_updated& evt) noexcept;
 
         void update() noexcept final;
     };
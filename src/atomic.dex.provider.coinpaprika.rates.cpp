@@ -0,0 +1,283 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+//! Project Headers
+#include "atomic.dex.provider.coinpaprika.rates.hpp"
+
+namespace
+{
+    constexpr double g_unknown_rate = std::numeric_limits<double>::quiet_NaN();
+
+    //! Rate of one USD in the given fiat from the openrates table (base USD)
+    double
+    get_usd_fiat_rate(const nlohmann::json& fiat_rates, const std::string& fiat) noexcept
+    {
+        if (fiat == "USD")
+        {
+            return 1.0;
+        }
+        if (not fiat_rates.contains("rates") || not fiat_rates.at("rates").contains(fiat))
+        {
+            return g_unknown_rate;
+        }
+        const auto& rate = fiat_rates.at("rates").at(fiat);
+        return rate.is_number() ? rate.get<double>() : g_unknown_rate;
+    }
+} // namespace
+
+namespace atomic_dex
+{
+    rates_snapshot::rates_snapshot(const t_coins_quotes& quotes, const std::vector<std::string>& currencies, const nlohmann::json& fiat_rates, double kmd_usd_price)
+    {
+        auto& interner = get_ticker_interner();
+        m_tickers.reserve(quotes.size());
+        for (auto&& [ticker, cur_quotes]: quotes)
+        {
+            if (const auto ticker_id = interner.intern(ticker); ticker_id != g_invalid_ticker_id)
+            {
+                m_tickers.push_back(ticker_id);
+                m_nb_rows = std::max<std::size_t>(m_nb_rows, ticker_id + 1);
+            }
+        }
+        m_has_quotes.assign(m_nb_rows, false);
+        for (auto&& ticker_id: m_tickers) { m_has_quotes[ticker_id] = true; }
+        m_currency_ids.reserve(currencies.size());
+        m_rates.assign(m_nb_rows * currencies.size(), g_unknown_rate);
+
+        //! Multipliers applied to the usd price are resolved once per currency and not once per cell
+        std::vector<double> usd_multipliers(currencies.size(), g_unknown_rate);
+        for (std::size_t currency_id = 0; currency_id < currencies.size(); ++currency_id)
+        {
+            const auto& currency = currencies[currency_id];
+            m_currency_ids.emplace(currency, currency_id);
+            if (currency == "KMD")
+            {
+                usd_multipliers[currency_id] = kmd_usd_price > 0.0 ? 1.0 / kmd_usd_price : g_unknown_rate;
+            }
+            else if (currency != "BTC")
+            {
+                usd_multipliers[currency_id] = get_usd_fiat_rate(fiat_rates, currency);
+            }
+        }
+
+        for (auto&& ticker_id: m_tickers)
+        {
+            const auto& ticker     = interner.get_ticker(ticker_id);
+            const auto& cur_quotes = quotes.at(ticker);
+            double*     row        = m_rates.data() + ticker_id * currencies.size();
+            for (std::size_t currency_id = 0; currency_id < currencies.size(); ++currency_id)
+            {
+                const auto& currency = currencies[currency_id];
+                if (currency == ticker)
+                {
+                    row[currency_id] = 1.0;
+                }
+                else if (currency == "BTC")
+                {
+                    row[currency_id] = cur_quotes.btc;
+                }
+                else
+                {
+                    row[currency_id] = cur_quotes.usd * usd_multipliers[currency_id];
+                }
+            }
+        }
+    }
+
+    std::size_t
+    rates_snapshot::get_nb_currencies() const noexcept
+    {
+        return m_currency_ids.size();
+    }
+
+    std::size_t
+    rates_snapshot::get_ticker_id(const std::string& ticker) const noexcept
+    {
+        const auto ticker_id = get_ticker_interner().find(ticker);
+        if (ticker_id >= m_nb_rows || not m_has_quotes[ticker_id])
+        {
+            return invalid_id;
+        }
+        return ticker_id;
+    }
+
+    std::size_t
+    rates_snapshot::get_currency_id(const std::string& currency) const noexcept
+    {
+        const auto it = m_currency_ids.find(currency);
+        return it != m_currency_ids.end() ? it->second : invalid_id;
+    }
+
+    double
+    rates_snapshot::get_rate(std::size_t ticker_id, std::size_t currency_id) const noexcept
+    {
+        if (ticker_id >= m_nb_rows || currency_id >= m_currency_ids.size())
+        {
+            return g_unknown_rate;
+        }
+        return m_rates[ticker_id * m_currency_ids.size() + currency_id];
+    }
+
+    std::optional<double>
+    rates_snapshot::get_rate(const std::string& currency, const std::string& ticker) const noexcept
+    {
+        const double rate = get_rate(get_ticker_id(ticker), get_currency_id(currency));
+        if (std::isnan(rate))
+        {
+            return std::nullopt;
+        }
+        return rate;
+    }
+
+    rates_diff
+    rates_snapshot::diff(const rates_snapshot& before, const rates_snapshot& after)
+    {
+        const auto same_rate = [](double lhs, double rhs) { return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs)); };
+
+        //! Currencies of both snapshots, with their id in each of them (invalid_id when missing)
+        std::vector<std::tuple<std::string, std::size_t, std::size_t>> currencies;
+        for (auto&& [currency, currency_id]: after.m_currency_ids) { currencies.emplace_back(currency, before.get_currency_id(currency), currency_id); }
+        for (auto&& [currency, currency_id]: before.m_currency_ids)
+        {
+            if (after.m_currency_ids.count(currency) == 0)
+            {
+                currencies.emplace_back(currency, currency_id, invalid_id);
+            }
+        }
+
+        //! Ticker ids are shared by both snapshots, disabled coins are in before only and their known rates disappear
+        std::vector<t_ticker_id> tickers(after.m_tickers);
+        tickers.insert(tickers.end(), before.m_tickers.begin(), before.m_tickers.end());
+        std::sort(tickers.begin(), tickers.end());
+        tickers.erase(std::unique(tickers.begin(), tickers.end()), tickers.end());
+
+        std::vector<bool> changed_currencies(currencies.size(), false);
+        rates_diff        out;
+        for (auto&& ticker_id: tickers)
+        {
+            bool changed = false;
+            for (std::size_t idx = 0; idx < currencies.size(); ++idx)
+            {
+                const auto& [currency, before_currency_id, after_currency_id] = currencies[idx];
+                if (not same_rate(before.get_rate(ticker_id, before_currency_id), after.get_rate(ticker_id, after_currency_id)))
+                {
+                    changed                 = true;
+                    changed_currencies[idx] = true;
+                }
+            }
+            if (changed)
+            {
+                out.tickers.push_back(get_ticker_interner().get_ticker(ticker_id));
+            }
+        }
+
+        for (std::size_t idx = 0; idx < currencies.size(); ++idx)
+        {
+            if (changed_currencies[idx])
+            {
+                out.currencies.push_back(std::get<0>(currencies[idx]));
+            }
+        }
+        return out;
+    }
+
+    void
+    portfolio_totals::apply(t_ticker_id ticker_id, double balance_delta) noexcept
+    {
+        for (std::size_t currency_id = 0; currency_id < m_totals.size(); ++currency_id)
+        {
+            //! Unknown rates don't contribute, like a coin without price
+            if (const double rate = m_snapshot->get_rate(ticker_id, currency_id); not std::isnan(rate))
+            {
+                m_totals[currency_id] += balance_delta * rate;
+            }
+        }
+    }
+
+    void
+    portfolio_totals::set_balance(const std::string& ticker, double balance) noexcept
+    {
+        const auto ticker_id = get_ticker_interner().intern(ticker);
+        if (ticker_id == g_invalid_ticker_id)
+        {
+            return;
+        }
+
+        std::scoped_lock lock(m_totals_mutex);
+        if (ticker_id >= m_balances.size())
+        {
+            m_balances.resize(ticker_id + 1, 0.0);
+        }
+        apply(ticker_id, balance - m_balances[ticker_id]);
+        m_balances[ticker_id] = balance;
+    }
+
+    void
+    portfolio_totals::remove_balance(const std::string& ticker) noexcept
+    {
+        const auto       ticker_id = get_ticker_interner().find(ticker);
+        std::scoped_lock lock(m_totals_mutex);
+        if (ticker_id < m_balances.size())
+        {
+            apply(ticker_id, -m_balances[ticker_id]);
+            m_balances[ticker_id] = 0.0;
+        }
+    }
+
+    void
+    portfolio_totals::set_rates(std::shared_ptr<const rates_snapshot> snapshot) noexcept
+    {
+        std::scoped_lock lock(m_totals_mutex);
+        m_snapshot = std::move(snapshot);
+        //! Starting from zero also drops the rounding errors accumulated by the deltas
+        m_totals.assign(m_snapshot->get_nb_currencies(), 0.0);
+        for (std::size_t ticker_id = 0; ticker_id < m_balances.size(); ++ticker_id)
+        {
+            if (m_balances[ticker_id] != 0.0)
+            {
+                apply(static_cast<t_ticker_id>(ticker_id), m_balances[ticker_id]);
+            }
+        }
+    }
+
+    double
+    portfolio_totals::get_total(const std::string& currency) const noexcept
+    {
+        std::scoped_lock lock(m_totals_mutex);
+        const auto       currency_id = m_snapshot->get_currency_id(currency);
+        return currency_id < m_totals.size() ? m_totals[currency_id] : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    std::string
+    rate_to_string(double rate)
+    {
+        if (rate == 0.0 || not std::isfinite(rate))
+        {
+            return "0";
+        }
+
+        //! The number of decimals follows the magnitude, a fixed count would turn the tiny rates into 0
+        const int   magnitude = static_cast<int>(std::floor(std::log10(std::abs(rate))));
+        const int   decimals  = std::max(0, std::numeric_limits<double>::digits10 - 1 - magnitude);
+        std::string result    = t_float_50(rate).str(decimals, std::ios_base::fixed);
+        if (result.find('.') != std::string::npos)
+        {
+            boost::trim_right_if(result, boost::is_any_of("0"));
+            boost::trim_right_if(result, boost::is_any_of("."));
+        }
+        return result;
+    }
+} // namespace atomic_dex
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include "atomic.dex.pch.hpp"
+#include "atomic.dex.ticker.interner.hpp"
+
+namespace atomic_dex
+{
+    //! Numeric quotes of one coin as returned by coinpaprika, NaN when the quote is missing
+    //! Only USD is needed for the fiats, they are all derived from it with the openrates table
+    struct coin_quotes
+    {
+        double usd{std::numeric_limits<double>::quiet_NaN()};
+        double btc{std::numeric_limits<double>::quiet_NaN()};
+    };
+
+    //! Tickers and currencies having at least one rate that differs between two snapshots
+    struct rates_diff
+    {
+        std::vector<std::string> tickers;
+        std::vector<std::string> currencies;
+
+        [[nodiscard]] bool
+        empty() const noexcept
+        {
+            return tickers.empty() && currencies.empty();
+        }
+    };
+
+    //! Immutable rate matrix (tickers x currencies) built once per fetch and swapped atomically by the provider
+    class rates_snapshot
+    {
+      public:
+        using t_coins_quotes = std::unordered_map<std::string, coin_quotes>;
+
+        static constexpr std::size_t invalid_id = std::numeric_limits<std::size_t>::max();
+
+      private:
+        std::vector<t_ticker_id>                     m_tickers;    ///< tickers having quotes in this snapshot
+        std::vector<bool>                            m_has_quotes; ///< indexed by ticker id
+        std::size_t                                  m_nb_rows{0};
+        std::unordered_map<std::string, std::size_t> m_currency_ids;
+        std::vector<double>                          m_rates; ///< row major, one row per interned ticker id, NaN when a rate is unknown
+
+      public:
+        //! Constructors
+        rates_snapshot() = default;
+        rates_snapshot(const t_coins_quotes& quotes, const std::vector<std::string>& currencies, const nlohmann::json& fiat_rates, double kmd_usd_price);
+
+        [[nodiscard]] std::size_t get_nb_currencies() const noexcept;
+
+        //! Ticker ids are the interned ones and can be kept across snapshots, currency ids are only valid for the snapshot that returned them
+        //! invalid_id if the snapshot doesn't know them
+        [[nodiscard]] std::size_t get_ticker_id(const std::string& ticker) const noexcept;
+        [[nodiscard]] std::size_t get_currency_id(const std::string& currency) const noexcept;
+
+        //! Price of one ticker unit in the given currency, NaN if unknown
+        [[nodiscard]] double get_rate(std::size_t ticker_id, std::size_t currency_id) const noexcept;
+
+        //! Same as above with a lookup of both ids
+        [[nodiscard]] std::optional<double> get_rate(const std::string& currency, const std::string& ticker) const noexcept;
+
+        //! A rate that appears or disappears is a change, two unknown rates are equal
+        [[nodiscard]] static rates_diff diff(const rates_snapshot& before, const rates_snapshot& after);
+    };
+
+    //! Value of the whole portfolio in every currency, a balance update only touches the row of its ticker
+    class portfolio_totals
+    {
+        mutable std::mutex                    m_totals_mutex;
+        std::shared_ptr<const rates_snapshot> m_snapshot{std::make_shared<const rates_snapshot>()};
+        std::vector<double>                   m_balances; ///< indexed by ticker id
+        std::vector<double>                   m_totals;   ///< indexed by the currency ids of m_snapshot
+
+        //! Private API, m_totals_mutex must be held
+        void apply(t_ticker_id ticker_id, double balance_delta) noexcept;
+
+      public:
+        //! O(nb_currencies)
+        void set_balance(const std::string& ticker, double balance) noexcept;
+        void remove_balance(const std::string& ticker) noexcept;
+
+        //! New rate matrix, every total is recomputed once from the known balances
+        void set_rates(std::shared_ptr<const rates_snapshot> snapshot) noexcept;
+
+        //! NaN if the currency is not supported
+        [[nodiscard]] double get_total(const std::string& currency) const noexcept;
+    };
+
+    //! Unadjusted rate with every significant digit of a double in a fixed notation, trailing zeros removed
+    std::string rate_to_string(double rate);
+} // namespace atomic_dex
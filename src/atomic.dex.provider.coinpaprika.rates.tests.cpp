@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.provider.coinpaprika.rates.hpp"
+#include <doctest/doctest.h>
+
+TEST_CASE("atomic dex rates snapshot")
+{
+    using atomic_dex::coin_quotes;
+    using atomic_dex::rates_snapshot;
+
+    const rates_snapshot::t_coins_quotes quotes{{"KMD", coin_quotes{.usd = 0.5, .btc = 0.00005}}, {"BTC", coin_quotes{.usd = 10000.0}}, {"RICK", coin_quotes{}}};
+    const auto                           fiat_rates = R"({"base":"USD","rates":{"EUR":0.9,"GBP":0.8}})"_json;
+    const rates_snapshot                 snapshot(quotes, {"USD", "EUR", "BTC", "KMD", "GBP", "JPY"}, fiat_rates, 0.5);
+
+    CHECK_EQ(snapshot.get_rate("USD", "KMD").value(), doctest::Approx(0.5));
+    CHECK_EQ(snapshot.get_rate("EUR", "BTC").value(), doctest::Approx(9000.0));
+    CHECK_EQ(snapshot.get_rate("KMD", "BTC").value(), doctest::Approx(20000.0));
+    CHECK_EQ(snapshot.get_rate("KMD", "KMD").value(), doctest::Approx(1.0));
+    CHECK_EQ(snapshot.get_rate("BTC", "BTC").value(), doctest::Approx(1.0));
+    CHECK_EQ(snapshot.get_rate("GBP", "KMD").value(), doctest::Approx(0.4));
+
+    //! Unknown fiat rate, quote, currency or ticker
+    CHECK_FALSE(snapshot.get_rate("JPY", "KMD").has_value());
+    CHECK_FALSE(snapshot.get_rate("USD", "RICK").has_value());
+    CHECK_FALSE(snapshot.get_rate("CHF", "KMD").has_value());
+    CHECK_FALSE(snapshot.get_rate("USD", "DOGE").has_value());
+    CHECK_EQ(snapshot.get_ticker_id("DOGE"), rates_snapshot::invalid_id);
+}
+
+TEST_CASE("atomic dex rates snapshot diff")
+{
+    using atomic_dex::coin_quotes;
+    using atomic_dex::rates_snapshot;
+
+    const std::vector<std::string> currencies{"USD", "EUR"};
+    const rates_snapshot           before(
+        {{"KMD", coin_quotes{.usd = 0.5}}, {"BTC", coin_quotes{.usd = 10000.0}}, {"RICK", coin_quotes{.usd = 1.0}}}, currencies, nlohmann::json::object(), 0.5);
+    const rates_snapshot after(
+        {{"KMD", coin_quotes{.usd = 0.5}}, {"BTC", coin_quotes{.usd = 11000.0}}, {"DOGE", coin_quotes{.usd = 0.002}}}, currencies, nlohmann::json::object(), 0.5);
+
+    CHECK(rates_snapshot::diff(before, before).empty());
+
+    //! BTC changed, DOGE appeared and RICK disappeared, only in USD since the EUR rates are unknown without a fiat table
+    auto changes = rates_snapshot::diff(before, after);
+    std::sort(begin(changes.tickers), end(changes.tickers));
+    CHECK_EQ(changes.tickers, std::vector<std::string>{"BTC", "DOGE", "RICK"});
+    CHECK_EQ(changes.currencies, std::vector<std::string>{"USD"});
+
+    CHECK_EQ(rates_snapshot::diff(rates_snapshot{}, before).tickers.size(), 3);
+}
+
+TEST_CASE("atomic dex portfolio totals")
+{
+    using atomic_dex::coin_quotes;
+    using atomic_dex::rates_snapshot;
+
+    const rates_snapshot::t_coins_quotes quotes{{"KMD", coin_quotes{.usd = 0.5}}, {"BTC", coin_quotes{.usd = 10000.0}}};
+    atomic_dex::portfolio_totals         totals;
+
+    //! No rates yet
+    totals.set_balance("KMD", 100.0);
+    CHECK(std::isnan(totals.get_total("USD")));
+
+    totals.set_rates(std::make_shared<const rates_snapshot>(quotes, std::vector<std::string>{"USD", "EUR"}, R"({"rates":{"EUR":0.9}})"_json, 0.5));
+    CHECK_EQ(totals.get_total("USD"), doctest::Approx(50.0));
+
+    totals.set_balance("BTC", 0.5);
+    totals.set_balance("KMD", 10.0);
+    CHECK_EQ(totals.get_total("USD"), doctest::Approx(5005.0));
+    CHECK_EQ(totals.get_total("EUR"), doctest::Approx(4504.5));
+
+    totals.remove_balance("BTC");
+    CHECK_EQ(totals.get_total("USD"), doctest::Approx(5.0));
+    CHECK(std::isnan(totals.get_total("GBP")));
+}
+
+TEST_CASE("atomic dex rate to string")
+{
+    using atomic_dex::rate_to_string;
+
+    CHECK_EQ(rate_to_string(0.0), "0");
+    CHECK_EQ(rate_to_string(0.1), "0.1");
+    CHECK_EQ(rate_to_string(9345.67), "9345.67");
+    CHECK_EQ(rate_to_string(100.0), "100");
+    CHECK_EQ(rate_to_string(0.00001234), "0.00001234");
+
+    //! Below 1e-12 a fixed count of decimals used to give "0"
+    CHECK_EQ(rate_to_string(1.5e-13), "0.00000000000015");
+    CHECK_EQ(rate_to_string(2.5e-18), "0.0000000000000000025");
+}
@@ -12,6 +12,9 @@ namespace atomic_dex
         refresh_update_status            = 4,
         post_process_orders_finished     = 5,
         post_process_swaps_finished      = 6,
+        refresh_rates                    = 7,
+        refresh_activation_progress      = 8,
+        post_process_coins_disabled      = 9,
     };
 
     inline constexpr std::size_t g_max_actions_size{128};
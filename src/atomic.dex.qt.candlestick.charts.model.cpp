@@ -14,10 +14,6 @@
  *                                                                            *
  ******************************************************************************/
 
-//! QT
-#include <QJsonDocument>
-#include <QJsonObject>
-
 //! PCH
 #include "atomic.dex.pch.hpp"
 
@@ -26,6 +22,37 @@
 #include "atomic.dex.qt.candlestick.charts.model.hpp"
 #include "atomic.threadpool.hpp"
 
+namespace
+{
+    //! Under this width a candlestick is no longer readable, merge it with its neighbour instead
+    constexpr int         g_min_candle_width_in_pixels = 3;
+    constexpr std::size_t g_min_lod_size               = 64;
+
+    void
+    add_moving_averages(std::vector<atomic_dex::candlestick_data>& candles)
+    {
+        std::vector<double> sums;
+        sums.reserve(candles.size());
+        for (auto&& candle: candles) { sums.emplace_back(sums.empty() ? candle.open : sums.back() + candle.open); }
+
+        auto moving_average = [&sums, &candles](std::size_t idx, std::size_t num) {
+            int first_idx = static_cast<int>(idx) - static_cast<int>(num);
+            if (first_idx < 0)
+            {
+                first_idx = 0;
+                num       = idx;
+            }
+            return num == 0 ? candles[idx].open : (sums[idx] - sums[first_idx]) / num;
+        };
+
+        for (std::size_t idx = 0; idx < candles.size(); ++idx)
+        {
+            candles[idx].ma_20 = moving_average(idx, 20);
+            candles[idx].ma_50 = moving_average(idx, 50);
+        }
+    }
+} // namespace
+
 namespace atomic_dex
 {
     candlestick_charts_model::candlestick_charts_model(ag::ecs::system_manager& system_manager, QObject* parent) :
@@ -44,11 +71,7 @@ namespace atomic_dex
     int
     candlestick_charts_model::rowCount([[maybe_unused]] const QModelIndex& parent) const
     {
-        if (m_model_data.empty())
-        {
-            return 0;
-        }
-        return m_model_data.size();
+        return static_cast<int>(get_current_lod().size());
     }
 
     int
@@ -72,43 +95,38 @@ namespace atomic_dex
             return QVariant();
         }
 
+        const auto& candle = get_current_lod()[index.row()];
         switch (index.column())
         {
         case 0:
-            return m_model_data.at(index.row()).at("timestamp").get<unsigned long long>() * 1000ull;
+            return static_cast<unsigned long long>(candle.timestamp) * 1000ull;
         case 1:
-            return m_model_data.at(index.row()).at("open").get<double>();
+            return candle.open;
         case 2:
-            return m_model_data.at(index.row()).at("high").get<double>();
+            return candle.high;
         case 3:
-            return m_model_data.at(index.row()).at("low").get<double>();
+            return candle.low;
         case 4:
-            return m_model_data.at(index.row()).at("close").get<double>();
+            return candle.close;
         case 5:
-            return m_model_data.at(index.row()).at("volume").get<double>();
+            return candle.volume;
 
         // Volume Candlestick chart
         case 6: // Open
-            return m_model_data.at(index.row()).at("close").get<double>() >= m_model_data.at(index.row()).at("open").get<double>()
-                       ? 0
-                       : m_model_data.at(index.row()).at("volume").get<double>();
+            return candle.close >= candle.open ? 0 : candle.volume;
         case 7: // High
-            return m_model_data.at(index.row()).at("volume").get<double>();
+            return candle.volume;
         case 8: // Low
             return 0;
         case 9: // Close
-            return m_model_data.at(index.row()).at("close").get<double>() >= m_model_data.at(index.row()).at("open").get<double>()
-                       ? m_model_data.at(index.row()).at("volume").get<double>()
-                       : 0;
+            return candle.close >= candle.open ? candle.volume : 0;
 
         //! MA 20
         case 10:
-            return m_model_data.at(index.row()).contains("ma_20") ? m_model_data.at(index.row()).at("ma_20").get<double>()
-                                                                  : m_model_data.at(index.row()).at("open").get<double>();
+            return candle.ma_20;
         //! MA 50
         case 11:
-            return m_model_data.at(index.row()).contains("ma_50") ? m_model_data.at(index.row()).at("ma_50").get<double>()
-                                                                  : m_model_data.at(index.row()).at("open").get<double>();
+            return candle.ma_50;
         default:
             return QVariant();
         }
@@ -124,14 +142,45 @@ namespace atomic_dex
             return false;
         }
 
+        t_candlesticks candles;
+        provider.for_each_ohlc_candle(m_current_range, [&candles](const ohlc_candle_view& candle) {
+            const auto open = candle.open();
+            candles.emplace_back(candlestick_data{
+                .timestamp = candle.timestamp(),
+                .open      = open,
+                .high      = candle.high(),
+                .low       = candle.low(),
+                .close     = candle.close(),
+                .volume    = candle.volume(),
+                .ma_20     = open,
+                .ma_50     = open});
+        });
+        add_moving_averages(candles);
+
         this->beginResetModel();
-        this->m_model_data = provider.get_ohlc_data(m_current_range);
+        this->build_level_of_detail(std::move(candles));
         this->endResetModel();
         this->set_is_currently_fetching(false);
 
         return true;
     }
 
+    void
+    candlestick_charts_model::build_level_of_detail(t_candlesticks&& candles)
+    {
+        m_lod_timestamps.clear();
+        m_hovered_candle_idx = std::numeric_limits<std::size_t>::max();
+        m_lod_levels         = build_candlestick_lod_levels(std::move(candles), g_min_lod_size);
+        m_lod_timestamps.reserve(m_lod_levels.size());
+        for (auto&& level: m_lod_levels)
+        {
+            t_timestamps timestamps(level.size());
+            std::transform(begin(level), end(level), begin(timestamps), [](const candlestick_data& candle) { return candle.timestamp; });
+            m_lod_timestamps.emplace_back(std::move(timestamps));
+        }
+        m_current_lod = std::min(m_current_lod, m_lod_levels.empty() ? 0 : m_lod_levels.size() - 1);
+    }
+
     void
     candlestick_charts_model::init_data()
     {
@@ -141,20 +190,21 @@ namespace atomic_dex
         }
         emit chartFullyModelReset();
 
-        if (m_model_data.empty()) {
+        if (m_lod_levels.empty()) {
             //this->set_is_currently_fetching(false);
             return;
         }
-        double max_value = std::numeric_limits<double>::min();
-        double min_value = std::numeric_limits<double>::max();
+        const auto& candles   = m_lod_levels.front();
+        double      max_value = std::numeric_limits<double>::min();
+        double      min_value = std::numeric_limits<double>::max();
 
-        for (auto&& cur: m_model_data)
+        for (auto&& cur: candles)
         {
-            if (auto min_to_compare = cur.at("low").get<double>(); min_value > min_to_compare)
+            if (auto min_to_compare = cur.low; min_value > min_to_compare)
             {
                 min_value = min_to_compare;
             }
-            if (auto max_to_compare = cur.at("high").get<double>(); max_value < max_to_compare)
+            if (auto max_to_compare = cur.high; max_value < max_to_compare)
             {
                 max_value = max_to_compare;
             }
@@ -163,8 +213,8 @@ namespace atomic_dex
         this->set_global_min_value(min_value);
         this->set_global_max_value(max_value);
 
-        auto date_start       = m_model_data[int(this->m_model_data.size() * 0.9)].at("timestamp").get<int>();
-        auto date_end         = m_model_data.back().at("timestamp").get<int>();
+        auto date_start       = static_cast<int>(candles[int(candles.size() * 0.9)].timestamp);
+        auto date_end         = static_cast<int>(candles.back().timestamp);
         auto date_diff        = date_end - date_start;
         auto date_init_margin = date_diff * 0.1;
         date_start += date_init_margin;
@@ -201,7 +251,7 @@ namespace atomic_dex
     candlestick_charts_model::clear_data()
     {
         //! If it's already empty dont reset the model
-        if (this->m_model_data.empty())
+        if (this->m_lod_levels.empty())
         {
             spdlog::trace("already empty, skipping");
             return;
@@ -209,7 +259,10 @@ namespace atomic_dex
 
         spdlog::trace("clearing the chart candlestick model");
         beginResetModel();
-        this->m_model_data.clear();
+        this->m_lod_levels.clear();
+        this->m_lod_timestamps.clear();
+        this->m_current_lod        = 0;
+        this->m_hovered_candle_idx = std::numeric_limits<std::size_t>::max();
         this->set_min_value(0);
         this->set_max_value(0);
         endResetModel();
@@ -235,7 +288,7 @@ namespace atomic_dex
     QDateTime
     atomic_dex::candlestick_charts_model::get_series_to() const noexcept
     {
-        if (this->m_model_data.empty())
+        if (this->m_lod_levels.empty())
         {
             return QDateTime();
         }
@@ -245,7 +298,7 @@ namespace atomic_dex
     QDateTime
     atomic_dex::candlestick_charts_model::get_series_from() const noexcept
     {
-        if (this->m_model_data.empty())
+        if (this->m_lod_levels.empty())
         {
             return QDateTime();
         }
@@ -342,59 +395,91 @@ namespace atomic_dex
     void
     candlestick_charts_model::update_visible_range()
     {
-        auto from_timestamp  = get_series_from().toSecsSinceEpoch();
-        auto first_timestamp = m_model_data[0].at("timestamp").get<int>();
+        if (m_lod_levels.empty())
+        {
+            return;
+        }
+
+        const auto& candles         = m_lod_levels.front();
+        auto        from_timestamp  = get_series_from().toSecsSinceEpoch();
+        auto        first_timestamp = static_cast<qint64>(candles.front().timestamp);
         if (from_timestamp < first_timestamp)
         {
             from_timestamp = first_timestamp;
         }
 
         auto to_timestamp   = get_series_to().toSecsSinceEpoch();
-        auto last_timestamp = m_model_data[m_model_data.size() - 1].at("timestamp").get<int>();
+        auto last_timestamp = static_cast<qint64>(candles.back().timestamp);
         if (to_timestamp > last_timestamp)
         {
             to_timestamp = last_timestamp;
         }
 
-        auto from_it = std::lower_bound(begin(m_model_data), end(m_model_data), from_timestamp, [](const nlohmann::json& current_json, int timestamp) {
-            int res = current_json.at("timestamp").get<int>();
-            return res < timestamp;
-        });
+        auto timestamp_cmp = [](const candlestick_data& candle, qint64 timestamp) { return static_cast<qint64>(candle.timestamp) < timestamp; };
+        auto from_it       = std::lower_bound(begin(candles), end(candles), from_timestamp, timestamp_cmp);
+        auto to_it         = std::lower_bound(begin(candles), end(candles), to_timestamp, timestamp_cmp);
 
-        auto to_it = std::lower_bound(begin(m_model_data), end(m_model_data), to_timestamp, [](const nlohmann::json& current_json, int timestamp) {
-            int res = current_json.at("timestamp").get<int>();
-            return res < timestamp;
-        });
+        if (from_it != candles.end() && to_it != candles.end())
+        {
+            auto min_value_it = std::min_element(from_it, to_it, [](const candlestick_data& left, const candlestick_data& right) { return left.low < right.low; });
+            auto max_value_it =
+                std::max_element(from_it, to_it, [](const candlestick_data& left, const candlestick_data& right) { return left.high < right.high; });
+            auto max_volume_it =
+                std::max_element(from_it, to_it, [](const candlestick_data& left, const candlestick_data& right) { return left.volume < right.volume; });
+
+            if (from_it != to_it)
+            {
+                this->set_visible_min_value(min_value_it->low);
+                this->set_visible_max_value(max_value_it->high);
+                this->set_visible_max_volume(max_volume_it->volume);
+            }
+            this->update_level_of_detail(std::distance(from_it, to_it));
+        }
+    }
 
-        if (from_it != m_model_data.end() && to_it != m_model_data.end())
+    void
+    candlestick_charts_model::update_level_of_detail(std::size_t nb_visible_candles)
+    {
+        const auto wanted_lod = select_candlestick_lod(nb_visible_candles, m_visible_width, g_min_candle_width_in_pixels, m_lod_levels.size(), m_current_lod);
+        if (wanted_lod != m_current_lod)
         {
-            auto min_value_j = std::min_element(from_it, to_it, [](nlohmann::json& left, nlohmann::json& right) {
-                auto left_value  = left.at("low").get<double>();
-                auto right_value = right.at("low").get<double>();
-                return left_value < right_value;
-            });
-
-            auto max_value_j = std::max_element(from_it, to_it, [](nlohmann::json& left, nlohmann::json& right) {
-                auto left_value  = left.at("high").get<double>();
-                auto right_value = right.at("high").get<double>();
-                return left_value < right_value;
-            });
-
-            auto max_volume_j = std::max_element(from_it, to_it, [](nlohmann::json& left, nlohmann::json& right) {
-                auto left_value  = left.at("volume").get<double>();
-                auto right_value = right.at("volume").get<double>();
-                return left_value < right_value;
-            });
-
-            auto min_value  = min_value_j->at("low").get<double>();
-            auto max_value  = max_value_j->at("high").get<double>();
-            auto max_volume = max_volume_j->at("volume").get<double>();
-            this->set_visible_min_value(min_value);
-            this->set_visible_max_value(max_value);
-            this->set_visible_max_volume(max_volume);
+            spdlog::trace("candlestick level of detail {} -> {} ({} visible candles)", m_current_lod, wanted_lod, nb_visible_candles);
+            beginResetModel();
+            m_current_lod        = wanted_lod;
+            m_hovered_candle_idx = std::numeric_limits<std::size_t>::max();
+            endResetModel();
+            emit seriesSizeChanged(get_series_size());
+            //! The QML series are rebuilt from the model like after a fetch, not only resized
+            emit chartFullyModelReset();
         }
     }
 
+    const candlestick_charts_model::t_candlesticks&
+    candlestick_charts_model::get_current_lod() const noexcept
+    {
+        static const t_candlesticks empty_candles;
+        return m_lod_levels.empty() ? empty_candles : m_lod_levels[m_current_lod];
+    }
+
+    int
+    candlestick_charts_model::get_visible_width() const noexcept
+    {
+        return m_visible_width;
+    }
+
+    void
+    candlestick_charts_model::set_visible_width(int value)
+    {
+        if (value == m_visible_width)
+        {
+            return;
+        }
+
+        m_visible_width = value;
+        emit visibleWidthChanged(m_visible_width);
+        this->update_visible_range();
+    }
+
     double
     candlestick_charts_model::get_visible_max_volume() const noexcept
     {
@@ -484,18 +569,33 @@ namespace atomic_dex
     QVariantMap
     candlestick_charts_model::find_closest_ohlc_data(int timestamp)
     {
-        QVariantMap out;
+        if (m_lod_timestamps.empty() || timestamp < 0)
+        {
+            return QVariantMap();
+        }
 
-        auto it = std::lower_bound(rbegin(m_model_data), rend(m_model_data), timestamp, [](const nlohmann::json& current_json, int timestamp) {
-          int res = current_json.at("timestamp").get<int>();
-          return timestamp < res;
-        });
+        //! Last candle opened before the cursor
+        const auto& timestamps = m_lod_timestamps[m_current_lod];
+        auto        it         = std::upper_bound(begin(timestamps), end(timestamps), static_cast<std::uint64_t>(timestamp));
+        if (it == begin(timestamps))
+        {
+            return QVariantMap();
+        }
 
-        if (it != m_model_data.rend())
+        const std::size_t idx = std::distance(begin(timestamps), it) - 1;
+        if (idx != m_hovered_candle_idx)
         {
-            QJsonDocument q_json = QJsonDocument::fromJson(QString::fromStdString(it->dump()).toUtf8());
-            out                  = q_json.object().toVariantMap();
+            const auto& candle            = m_lod_levels[m_current_lod][idx];
+            m_hovered_candle_idx          = idx;
+            m_hovered_candle["timestamp"] = static_cast<qulonglong>(candle.timestamp);
+            m_hovered_candle["open"]      = candle.open;
+            m_hovered_candle["high"]      = candle.high;
+            m_hovered_candle["low"]       = candle.low;
+            m_hovered_candle["close"]     = candle.close;
+            m_hovered_candle["volume"]    = candle.volume;
+            m_hovered_candle["ma_20"]     = candle.ma_20;
+            m_hovered_candle["ma_50"]     = candle.ma_50;
         }
-        return out;
+        return m_hovered_candle;
     }
 } // namespace atomic_dex
\ No newline at end of file
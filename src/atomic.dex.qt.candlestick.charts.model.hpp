@@ -22,6 +22,9 @@
 //! PCH
 #include "atomic.dex.pch.hpp"
 
+//! Project Headers
+#include "atomic.dex.candlestick.lod.hpp"
+
 namespace atomic_dex
 {
     class candlestick_charts_model final : public QAbstractTableModel
@@ -40,6 +43,10 @@ namespace atomic_dex
         Q_PROPERTY(double visible_max_volume READ get_visible_max_volume WRITE set_visible_max_volume NOTIFY visibleMaxVolumeChanged)
         Q_PROPERTY(bool is_current_pair_supported READ is_pair_supported WRITE set_is_pair_supported NOTIFY pairSupportedChanged)
         Q_PROPERTY(bool is_fetching READ is_currently_fetching WRITE set_is_currently_fetching NOTIFY fetchingStatusChanged)
+        Q_PROPERTY(int visible_width READ get_visible_width WRITE set_visible_width NOTIFY visibleWidthChanged)
+
+        using t_candlesticks = std::vector<candlestick_data>;
+        using t_timestamps   = std::vector<std::uint64_t>;
 
       public:
         candlestick_charts_model(ag::ecs::system_manager& system_manager, QObject* parent = nullptr);
@@ -81,6 +88,8 @@ namespace atomic_dex
         void                    set_visible_max_volume(double value);
         void                    set_series_from(QDateTime value);
         void                    set_series_to(QDateTime value);
+        [[nodiscard]] int       get_visible_width() const noexcept;
+        void                    set_visible_width(int value);
 
       signals:
         void seriesSizeChanged(int value);
@@ -99,22 +108,35 @@ namespace atomic_dex
         void maTwentySeriesChanged();
         void maFiftySeriesChanged();
         void chartFullyModelReset();
+        void visibleWidthChanged(int value);
 
       private:
         void set_global_min_value(double value);
         void set_global_max_value(double value);
         void update_visible_range();
+        void update_level_of_detail(std::size_t nb_visible_candles);
 
         bool common_reset_data();
+        void build_level_of_detail(t_candlesticks&& candles);
+
+        [[nodiscard]] const t_candlesticks& get_current_lod() const noexcept;
 
         ag::ecs::system_manager& m_system_manager;
 
-        nlohmann::json m_model_data;
+        //! m_lod_levels[0] is the full series, each next level merges two candles of the precedent one
+        std::vector<t_candlesticks> m_lod_levels;
+        std::vector<t_timestamps>   m_lod_timestamps; //! contiguous copy of the timestamps of each level for the hover lookup
+        std::size_t                 m_current_lod{0};
+
+        //! Last candle returned by find_closest_ohlc_data, reused as long as the cursor stays over it
+        QVariantMap m_hovered_candle;
+        std::size_t m_hovered_candle_idx{std::numeric_limits<std::size_t>::max()};
 
         std::string m_current_range{"3600"}; //! 1h
 
         bool      m_current_pair_supported{false};
         bool      m_currently_fetching{false};
+        int       m_visible_width{0};
         double    m_visible_min_value{0};
         double    m_visible_max_value{0};
         double    m_visible_max_volume{0};
@@ -16,8 +16,10 @@
 
 #pragma once
 
-#include <QJsonArray>
 #include <QString>
+#include <QVariantList>
+
+#include "atomic.dex.ticker.interner.hpp"
 
 namespace atomic_dex
 {
@@ -26,6 +28,9 @@ namespace atomic_dex
         //! eg: BTC,ETH,KMD (constant)
         const QString ticker;
 
+        //! Interned id of the ticker, used to find the row without comparing strings
+        const t_ticker_id ticker_id{g_invalid_ticker_id};
+
         //! eg: Bitcoin
         const QString name;
 
@@ -41,8 +46,8 @@ namespace atomic_dex
         //! eg: 9400 $
         QString main_currency_price_for_one_unit;
 
-        //! Paprika data rates
-        QJsonArray trend_7d;
+        //! Down-sampled 7 days prices
+        QVariantList trend_7d;
 
         bool is_excluded{false};
 
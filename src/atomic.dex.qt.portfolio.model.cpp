@@ -23,6 +23,9 @@
 //! Utils
 namespace
 {
+    //! The trend column is a 200 pixels wide chart, one point every 4 hours is enough for it
+    constexpr std::size_t g_trend_7d_nb_points = 42;
+
     void
     update_value(atomic_dex::portfolio_model::PortfolioRoles role, const QString& value, const QModelIndex& idx, atomic_dex::portfolio_model& model)
     {
@@ -73,18 +76,27 @@ namespace atomic_dex
         const QString   change_24h = retrieve_change_24h(paprika, coin, *m_config);
         portfolio_data  data{
             .ticker                           = QString::fromStdString(coin.ticker),
+            .ticker_id                        = get_ticker_interner().intern(coin.ticker),
             .name                             = QString::fromStdString(coin.name),
             .balance                          = QString::fromStdString(mm2_system.my_balance(coin.ticker, ec)),
             .main_currency_balance            = QString::fromStdString(paprika.get_price_in_fiat(m_config->current_currency, coin.ticker, ec)),
             .change_24h                       = change_24h,
             .main_currency_price_for_one_unit = QString::fromStdString(paprika.get_rate_conversion(m_config->current_currency, coin.ticker, ec, true)),
-            .trend_7d                         = nlohmann_json_array_to_qt_json_array(paprika.get_ticker_historical(coin.ticker).answer),
+            .trend_7d                         = sparkline_to_qt_variant_list(paprika.get_ticker_sparkline(coin.ticker, g_trend_7d_nb_points)),
             .is_excluded                      = false,
         };
         data.display = data.ticker + " (" + data.balance + ")";
         spdlog::trace(
             "inserting ticker {} with name {} balance {} main currency balance {}", coin.ticker, coin.name, data.balance.toStdString(),
             data.main_currency_balance.toStdString());
+        if (data.ticker_id != g_invalid_ticker_id)
+        {
+            if (data.ticker_id >= m_ticker_rows.size())
+            {
+                m_ticker_rows.resize(data.ticker_id + 1, -1);
+            }
+            m_ticker_rows[data.ticker_id] = this->m_model_data.count();
+        }
         this->m_model_data.push_back(std::move(data));
         endInsertRows();
         spdlog::trace("size of the portfolio {}", this->get_length());
@@ -96,18 +108,17 @@ namespace atomic_dex
     {
         const auto&                    mm2_system = this->m_system_manager.get_system<mm2>();
         const auto&                    paprika    = this->m_system_manager.get_system<coinpaprika_provider>();
-        t_coins                        coins      = mm2_system.get_enabled_coins();
+        const t_coins_view             coins      = mm2_system.get_enabled_coins();
         const std::string&             currency   = m_config->current_currency;
         std::vector<std::future<void>> pending_tasks;
-        for (auto&& coin: coins)
+        for (auto&& coin: *coins)
         {
             pending_tasks.push_back(spawn([coin, &paprika, &mm2_system, currency, this]() {
                 const std::string& ticker = coin.ticker;
-                if (const auto res = this->match(this->index(0, 0), TickerRole, QString::fromStdString(ticker)); not res.isEmpty())
+                if (const QModelIndex idx = get_ticker_index(ticker); idx.isValid())
                 {
-                    std::error_code    ec;
-                    const QModelIndex& idx                         = res.at(0);
-                    const QString      main_currency_balance_value = QString::fromStdString(paprika.get_price_in_fiat(currency, ticker, ec));
+                    std::error_code ec;
+                    const QString   main_currency_balance_value = QString::fromStdString(paprika.get_price_in_fiat(currency, ticker, ec));
                     update_value(MainCurrencyBalanceRole, main_currency_balance_value, idx, *this);
                     const QString currency_price_for_one_unit = QString::fromStdString(paprika.get_rate_conversion(currency, ticker, ec, true));
                     update_value(MainCurrencyPriceForOneUnit, currency_price_for_one_unit, idx, *this);
@@ -126,13 +137,12 @@ namespace atomic_dex
     void
     portfolio_model::update_balance_values(const std::string& ticker) noexcept
     {
-        if (const auto res = this->match(this->index(0, 0), TickerRole, QString::fromStdString(ticker)); not res.isEmpty())
+        if (const QModelIndex idx = get_ticker_index(ticker); idx.isValid())
         {
             const auto&        mm2_system = this->m_system_manager.get_system<mm2>();
             const auto&        paprika    = this->m_system_manager.get_system<coinpaprika_provider>();
             std::error_code    ec;
             const std::string& currency = m_config->current_currency;
-            const QModelIndex& idx      = res.at(0);
             const QString      balance  = QString::fromStdString(mm2_system.my_balance(ticker, ec));
             update_value(BalanceRole, balance, idx, *this);
             const QString main_currency_balance_value = QString::fromStdString(paprika.get_price_in_fiat(currency, ticker, ec));
@@ -144,6 +154,27 @@ namespace atomic_dex
         }
     }
 
+    void
+    portfolio_model::update_rates_values(const std::vector<std::string>& tickers) noexcept
+    {
+        const auto&        mm2_system = this->m_system_manager.get_system<mm2>();
+        const auto&        paprika    = this->m_system_manager.get_system<coinpaprika_provider>();
+        const std::string& currency   = m_config->current_currency;
+        for (auto&& ticker: tickers)
+        {
+            if (const QModelIndex idx = get_ticker_index(ticker); idx.isValid())
+            {
+                std::error_code ec;
+                const QString   main_currency_balance_value = QString::fromStdString(paprika.get_price_in_fiat(currency, ticker, ec));
+                update_value(MainCurrencyBalanceRole, main_currency_balance_value, idx, *this);
+                const QString currency_price_for_one_unit = QString::fromStdString(paprika.get_rate_conversion(currency, ticker, ec, true));
+                update_value(MainCurrencyPriceForOneUnit, currency_price_for_one_unit, idx, *this);
+                const QString change24_h = retrieve_change_24h(paprika, mm2_system.get_coin_info(ticker), *m_config);
+                update_value(Change24H, change24_h, idx, *this);
+            }
+        }
+    }
+
     QVariant
     atomic_dex::portfolio_model::data(const QModelIndex& index, int role) const
     {
@@ -201,7 +232,7 @@ namespace atomic_dex
             item.main_currency_price_for_one_unit = value.toString();
             break;
         case Trend7D:
-            item.trend_7d = value.toJsonArray();
+            item.trend_7d = value.toList();
             break;
         case Excluded:
             item.is_excluded = value.toBool();
@@ -228,6 +259,7 @@ namespace atomic_dex
             this->m_model_data.removeAt(position);
             emit lengthChanged();
         }
+        rebuild_ticker_rows();
         endRemoveRows();
 
         return true;
@@ -238,9 +270,10 @@ namespace atomic_dex
     {
         for (auto&& coin: coins)
         {
-            auto res = this->match(this->index(0, 0), TickerRole, coin);
-            assert(not res.empty());
-            this->removeRow(res.at(0).row());
+            if (const QModelIndex idx = get_ticker_index(coin.toStdString()); idx.isValid())
+            {
+                this->removeRow(idx.row());
+            }
         }
     }
 
@@ -289,6 +322,31 @@ namespace atomic_dex
     {
         this->beginResetModel();
         this->m_model_data.clear();
+        this->m_ticker_rows.clear();
         this->endResetModel();
     }
+
+    QModelIndex
+    portfolio_model::get_ticker_index(const std::string& ticker) const noexcept
+    {
+        const auto ticker_id = get_ticker_interner().find(ticker);
+        if (ticker_id >= m_ticker_rows.size() || m_ticker_rows[ticker_id] < 0)
+        {
+            return {};
+        }
+        return this->index(m_ticker_rows[ticker_id], 0);
+    }
+
+    void
+    portfolio_model::rebuild_ticker_rows() noexcept
+    {
+        std::fill(m_ticker_rows.begin(), m_ticker_rows.end(), -1);
+        for (int row = 0; row < m_model_data.count(); ++row)
+        {
+            if (const auto ticker_id = m_model_data.at(row).ticker_id; ticker_id < m_ticker_rows.size())
+            {
+                m_ticker_rows[ticker_id] = row;
+            }
+        }
+    }
 } // namespace atomic_dex
\ No newline at end of file
@@ -76,6 +76,7 @@ namespace atomic_dex
         void initialize_portfolio(std::string ticker);
         void update_currency_values();
         void update_balance_values(const std::string& ticker) noexcept;
+        void update_rates_values(const std::vector<std::string>& tickers) noexcept; ///< only the rows of the given tickers are touched
         void disable_coins(const QStringList& coins);
         void set_cfg(atomic_dex::cfg& cfg) noexcept;
 
@@ -99,6 +100,11 @@ namespace atomic_dex
         portfolio_proxy_model* m_model_proxy;
         //! Data holders
         t_portfolio_datas m_model_data;
+        std::vector<int>  m_ticker_rows; ///< row of each ticker id, -1 if the coin is not in the portfolio
+
+        //! Private API
+        [[nodiscard]] QModelIndex get_ticker_index(const std::string& ticker) const noexcept; ///< invalid index if the coin is not in the portfolio
+        void                      rebuild_ticker_rows() noexcept;
     };
 
 } // namespace atomic_dex
\ No newline at end of file
@@ -46,19 +46,45 @@ namespace atomic_dex
         return obj;
     }
 
+    QJsonArray
+    price_series_to_qt_json_array(const atomic_dex::price_series& series)
+    {
+        QJsonArray out;
+        for (std::size_t idx = 0; idx < series.timestamps.size(); ++idx)
+        {
+            //! Same fields as the coinpaprika answer, the timestamp is in milliseconds for the QML Date
+            out.append(QJsonObject{
+                {"timestamp", static_cast<double>(series.timestamps[idx]) * 1000.0},
+                {"price", static_cast<double>(series.prices[idx])},
+                {"volume_24h", static_cast<double>(series.volumes[idx])}});
+        }
+        return out;
+    }
+
+    QVariantList
+    sparkline_to_qt_variant_list(const std::vector<float>& sparkline)
+    {
+        QVariantList out;
+        out.reserve(static_cast<int>(sparkline.size()));
+        for (auto&& price: sparkline) { out.push_back(static_cast<double>(price)); }
+        return out;
+    }
+
     QString
     retrieve_change_24h(const atomic_dex::coinpaprika_provider& paprika, const atomic_dex::coin_config& coin, const atomic_dex::cfg& config)
     {
-        auto    ticker_infos = paprika.get_ticker_infos(coin.ticker).answer;
-        QString change_24h   = "0";
-        if (not ticker_infos.empty() && ticker_infos.contains(config.current_currency))
+        auto quote = paprika.get_ticker_quote(coin.ticker, config.current_currency);
+        if (not quote.has_value() && config.current_currency != "KMD")
+        {
+            //! Only USD and BTC are quoted, the USD change is the closest one for the other fiats
+            quote = paprika.get_ticker_quote(coin.ticker, "USD");
+        }
+        if (quote.has_value())
         {
-            auto change_24h_str =
-                std::to_string(paprika.get_ticker_infos(coin.ticker).answer.at(config.current_currency).at("percent_change_24h").get<double>());
-            std::replace(begin(change_24h_str), end(change_24h_str), ',', '.');
-            change_24h = QString::fromStdString(change_24h_str);
+            //! QString::number is locale independent, no need to fix the decimal separator
+            return QString::number(quote->percent_change_24h, 'f', 6);
         }
-        return change_24h;
+        return "0";
     }
 
     QStringList
@@ -28,9 +28,11 @@
 
 namespace atomic_dex
 {
-    bool        am_i_able_to_reach_this_endpoint(const QString& endpoint);
-    QStringList vector_std_string_to_qt_string_list(const std::vector<std::string>& vec);
-    QJsonArray  nlohmann_json_array_to_qt_json_array(const nlohmann::json& j);
-    QJsonObject nlohmann_json_object_to_qt_json_object(const nlohmann::json& j);
-    QString     retrieve_change_24h(const atomic_dex::coinpaprika_provider& paprika, const atomic_dex::coin_config& coin, const atomic_dex::cfg& config);
+    bool         am_i_able_to_reach_this_endpoint(const QString& endpoint);
+    QStringList  vector_std_string_to_qt_string_list(const std::vector<std::string>& vec);
+    QJsonArray   nlohmann_json_array_to_qt_json_array(const nlohmann::json& j);
+    QJsonObject  nlohmann_json_object_to_qt_json_object(const nlohmann::json& j);
+    QJsonArray   price_series_to_qt_json_array(const atomic_dex::price_series& series);
+    QVariantList sparkline_to_qt_variant_list(const std::vector<float>& sparkline);
+    QString      retrieve_change_24h(const atomic_dex::coinpaprika_provider& paprika, const atomic_dex::coin_config& coin, const atomic_dex::cfg& config);
 } // namespace atomic_dex
\ No newline at end of file
@@ -67,7 +67,11 @@ namespace atomic_dex
             const fs::path    wallet_object_path = get_atomic_dex_export_folder() / (wallet_name.toStdString() + ".wallet.json"s);
             const std::string wallet_cfg_file    = std::string(atomic_dex::get_raw_version()) + "-coins"s + "."s + wallet_name.toStdString() + ".json"s;
             const fs::path    wallet_cfg_path    = get_atomic_dex_config_folder() / wallet_cfg_file;
+            const fs::path    wallet_bin_path    = get_atomic_dex_config_folder() / (wallet_name.toStdString() + ".wallet.bin"s);
 
+            //! A previous wallet with the same name must not give its address book to the new one
+            boost::system::error_code remove_ec;
+            fs::remove(wallet_bin_path, remove_ec);
 
             if (not fs::exists(wallet_cfg_path))
             {
@@ -137,6 +141,8 @@ namespace atomic_dex
     qt_wallet_manager::delete_wallet(const QString& wallet_name) noexcept
     {
         using namespace std::string_literals;
+        boost::system::error_code ec;
+        fs::remove(get_atomic_dex_config_folder() / (wallet_name.toStdString() + ".wallet.bin"s), ec);
         return fs::remove(get_atomic_dex_config_folder() / (wallet_name.toStdString() + ".seed"s));
     }
 
@@ -168,34 +174,49 @@ namespace atomic_dex
     qt_wallet_manager::load_wallet_cfg(const std::string& wallet_name)
     {
         using namespace std::string_literals;
+        const fs::path wallet_bin_path    = get_atomic_dex_config_folder() / (wallet_name + ".wallet.bin"s);
         const fs::path wallet_object_path = get_atomic_dex_export_folder() / (wallet_name + ".wallet.json"s);
-        std::ifstream  ifs(wallet_object_path.string());
+        m_wallet_cfg_store.set_export_path(wallet_object_path);
+        if (auto cfg = m_wallet_cfg_store.load(wallet_bin_path); cfg.has_value())
+        {
+            m_wallet_cfg = std::move(cfg.value());
+            return true;
+        }
 
-        if (not ifs.is_open())
+        //! No binary configuration yet, import the json one written at the creation of the wallet
+        //! An unreadable binary file falls back to the json too, it is rewritten at every compaction so it holds the last snapshot
+        if (fs::exists(wallet_bin_path))
+        {
+            spdlog::warn("{} is unreadable, recovering the last snapshot from {}", wallet_bin_path.string(), wallet_object_path.string());
+        }
+        auto imported_cfg = wallet_cfg_store::import_json(wallet_object_path);
+        if (not imported_cfg.has_value())
         {
             return false;
         }
-        nlohmann::json j;
-        ifs >> j;
-        m_wallet_cfg = j;
+        m_wallet_cfg = std::move(imported_cfg.value());
+        m_wallet_cfg_store.save(m_wallet_cfg);
         return true;
     }
 
     bool
     qt_wallet_manager::update_wallet_cfg() noexcept
     {
-        using namespace std::string_literals;
-        const fs::path wallet_object_path = get_atomic_dex_export_folder() / (m_wallet_cfg.name + ".wallet.json"s);
-        std::ofstream  ofs(wallet_object_path.string(), std::ios::trunc);
-        if (not ofs.is_open())
+        //! Only the changes since the last call are appended to the file
+        return m_wallet_cfg_store.save(m_wallet_cfg);
+    }
+
+    bool
+    qt_wallet_manager::export_wallet_cfg() const noexcept
+    {
+        if (m_wallet_cfg.name.empty())
         {
             return false;
         }
 
-        nlohmann::json j;
-        atomic_dex::to_json(j, m_wallet_cfg);
-        ofs << j.dump(4);
-        return true;
+        using namespace std::string_literals;
+        const fs::path wallet_object_path = get_atomic_dex_export_folder() / (m_wallet_cfg.name + ".wallet.json"s);
+        return wallet_cfg_store::export_json(m_wallet_cfg, wallet_object_path);
     }
 
     void
@@ -26,8 +26,10 @@
 #include "atomic.dex.mm2.hpp"
 #include "atomic.dex.qt.addressbook.contact.contents.hpp"
 #include "atomic.dex.security.hpp"
+#include "atomic.dex.startup.tracer.hpp"
 #include "atomic.dex.version.hpp"
 #include "atomic.dex.wallet.config.hpp"
+#include "atomic.dex.wallet.config.store.hpp"
 
 namespace atomic_dex
 {
@@ -58,6 +60,9 @@ namespace atomic_dex
 
         bool update_wallet_cfg() noexcept;
 
+        //! Write the current configuration to <export_folder>/<wallet>.wallet.json, the binary file stays the reference
+        bool export_wallet_cfg() const noexcept;
+
         void                            update_contact_ticker(const QString& contact_name, const QString& old_ticker, const QString& new_ticker);
         void                            update_contact_address(const QString& contact_name, const QString& ticker, const QString& address);
         void                            update_or_insert_contact_name(const QString& old_contact_name, const QString& contact_name);
@@ -68,8 +73,9 @@ namespace atomic_dex
         const wallet_cfg&               get_wallet_cfg() noexcept;
 
       private:
-        wallet_cfg m_wallet_cfg;
-        QString    m_current_default_wallet{""};
+        wallet_cfg       m_wallet_cfg;
+        wallet_cfg_store m_wallet_cfg_store;
+        QString          m_current_default_wallet{""};
     };
 
     template <typename Functor>
@@ -86,7 +92,10 @@ namespace atomic_dex
 
             with_pin_cfg = true;
         }
-        auto key = atomic_dex::derive_password(password_std, ec);
+        auto key = [&]() {
+            startup_span span("derive_password");
+            return atomic_dex::derive_password(password_std, ec);
+        }();
         if (ec)
         {
             spdlog::warn("{}", ec.message());
@@ -111,7 +120,10 @@ namespace atomic_dex
             }
 
             const fs::path seed_path = get_atomic_dex_config_folder() / (wallet_name.toStdString() + ".seed"s);
-            auto           seed      = atomic_dex::decrypt(seed_path, key.data(), ec);
+            auto           seed      = [&]() {
+                startup_span span("decrypt");
+                return atomic_dex::decrypt(seed_path, key.data(), ec);
+            }();
             if (ec == dextop_error::corrupted_file_or_wrong_password)
             {
                 spdlog::warn("{}", ec.message());
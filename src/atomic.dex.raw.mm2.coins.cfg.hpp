@@ -108,8 +108,7 @@ namespace atomic_dex
 
 namespace atomic_dex
 {
-    using t_mm2_raw_coins          = std::vector<coin_element>;
-    using t_mm2_raw_coins_registry = std::unordered_map<std::string, coin_element>;
+    using t_mm2_raw_coins = std::vector<coin_element>;
 } // namespace atomic_dex
 
 namespace atomic_dex
@@ -201,27 +200,4 @@ namespace atomic_dex
         j["version_group_id"]       = x.version_group_id;
         j["consensus_branch_id"]    = x.consensus_branch_id;
     }
-
-    inline t_mm2_raw_coins_registry
-    parse_raw_mm2_coins_file()
-    {
-        t_mm2_raw_coins_registry out;
-        fs::path                 file_path{ag::core::assets_real_path() / "tools" / "mm2" / "coins"};
-        std::ifstream            ifs(file_path.string());
-        assert(ifs.is_open());
-        try
-        {
-            nlohmann::json j;
-            ifs >> j;
-            t_mm2_raw_coins coins = j;
-            out.reserve(coins.size());
-            for (auto&& coin: coins) { out[coin.coin] = coin; }
-            spdlog::info("successfully parsed: {}, nb_coins: {}", file_path.string(), out.size());
-        }
-        catch (const std::exception& error)
-        {
-            spdlog::error("cannot parse mm2 raw cfg file: {} {}", file_path.string(), error.what());
-        }
-        return out;
-    }
 } // namespace atomic_dex
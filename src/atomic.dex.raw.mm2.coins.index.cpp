@@ -0,0 +1,380 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+//! Project Headers
+#include "atomic.dex.raw.mm2.coins.index.hpp"
+#include "atomic.dex.startup.tracer.hpp"
+
+namespace
+{
+    constexpr std::array<char, 4> g_coins_index_magic{'C', 'I', 'D', 'X'};
+    constexpr std::uint32_t       g_coins_index_version = 1;
+
+    //! Byte ranges of the objects of the top level array, strings are skipped so a brace in a value doesn't count
+    std::vector<std::pair<std::size_t, std::size_t>>
+    scan_top_level_objects(const std::string& content) noexcept
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        std::size_t                                      depth       = 0;
+        std::size_t                                      begin_idx   = 0;
+        bool                                             in_string   = false;
+        bool                                             is_escaping = false;
+        for (std::size_t idx = 0; idx < content.size(); ++idx)
+        {
+            const char c = content[idx];
+            if (in_string)
+            {
+                if (is_escaping)
+                {
+                    is_escaping = false;
+                }
+                else if (c == '\\')
+                {
+                    is_escaping = true;
+                }
+                else if (c == '"')
+                {
+                    in_string = false;
+                }
+                continue;
+            }
+
+            switch (c)
+            {
+            case '"':
+                in_string = true;
+                break;
+            case '{':
+            case '[':
+                if (++depth == 2 && c == '{')
+                {
+                    begin_idx = idx;
+                }
+                break;
+            case '}':
+            case ']':
+                if (depth-- == 2 && c == '}')
+                {
+                    ranges.emplace_back(begin_idx, idx + 1 - begin_idx);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        return ranges;
+    }
+
+    //! Only reads the top level "coin" field, the parsing stops as soon as it is found
+    struct coin_name_sax final : nlohmann::json_sax<nlohmann::json>
+    {
+        bool
+        null() override
+        {
+            return true;
+        }
+
+        bool
+        boolean([[maybe_unused]] bool val) override
+        {
+            return true;
+        }
+
+        bool
+        number_integer([[maybe_unused]] number_integer_t val) override
+        {
+            return true;
+        }
+
+        bool
+        number_unsigned([[maybe_unused]] number_unsigned_t val) override
+        {
+            return true;
+        }
+
+        bool
+        number_float([[maybe_unused]] number_float_t val, [[maybe_unused]] const string_t& s) override
+        {
+            return true;
+        }
+
+        bool
+        string(string_t& val) override
+        {
+            if (m_depth == 1 && m_is_coin_key)
+            {
+                m_coin = std::move(val);
+                return false;
+            }
+            return true;
+        }
+
+        bool
+        start_object([[maybe_unused]] std::size_t elements) override
+        {
+            ++m_depth;
+            return true;
+        }
+
+        bool
+        key(string_t& val) override
+        {
+            m_is_coin_key = m_depth == 1 && val == "coin";
+            return true;
+        }
+
+        bool
+        end_object() override
+        {
+            --m_depth;
+            return true;
+        }
+
+        bool
+        start_array([[maybe_unused]] std::size_t elements) override
+        {
+            ++m_depth;
+            return true;
+        }
+
+        bool
+        end_array() override
+        {
+            --m_depth;
+            return true;
+        }
+
+        bool
+        parse_error(
+            [[maybe_unused]] std::size_t position, [[maybe_unused]] const std::string& last_token,
+            [[maybe_unused]] const nlohmann::detail::exception& ex) override
+        {
+            return false;
+        }
+
+        std::string m_coin;
+
+      private:
+        std::size_t m_depth{0};
+        bool        m_is_coin_key{false};
+    };
+
+    template <typename T>
+    void
+    write_pod(std::ostream& os, const T& value)
+    {
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool
+    read_pod(std::istream& is, T& value)
+    {
+        is.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return is.good();
+    }
+} // namespace
+
+namespace atomic_dex
+{
+    raw_mm2_coins_index::raw_mm2_coins_index(fs::path coins_path, fs::path index_path) noexcept :
+        m_coins_path(std::move(coins_path)), m_index_path(std::move(index_path))
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+    }
+
+    void
+    raw_mm2_coins_index::load() const noexcept
+    {
+        if (m_loaded)
+        {
+            return;
+        }
+        m_loaded = true;
+
+        startup_span              span("raw mm2 coins index");
+        boost::system::error_code ec;
+        const std::int64_t        mtime = static_cast<std::int64_t>(fs::last_write_time(m_coins_path, ec));
+        const std::uint64_t       size  = ec ? 0 : fs::file_size(m_coins_path, ec);
+        if (ec)
+        {
+            spdlog::error("cannot stat the mm2 coins file {}: {}", m_coins_path.string(), ec.message());
+            return;
+        }
+
+        if (not read_index(mtime, size))
+        {
+            build_index(mtime, size);
+        }
+    }
+
+    bool
+    raw_mm2_coins_index::read_index(std::int64_t mtime, std::uint64_t size) const noexcept
+    {
+        std::ifstream ifs(m_index_path.string(), std::ios::binary);
+        if (not ifs.is_open())
+        {
+            return false;
+        }
+
+        std::array<char, 4> magic{};
+        std::uint32_t       version       = 0;
+        std::int64_t        indexed_mtime = 0;
+        std::uint64_t       indexed_size  = 0;
+        std::uint32_t       nb_entries    = 0;
+        ifs.read(magic.data(), magic.size());
+        if (not read_pod(ifs, version) || not read_pod(ifs, indexed_mtime) || not read_pod(ifs, indexed_size) || not read_pod(ifs, nb_entries))
+        {
+            return false;
+        }
+        if (magic != g_coins_index_magic || version != g_coins_index_version || indexed_mtime != mtime || indexed_size != size)
+        {
+            spdlog::info("the mm2 coins index is outdated, rebuilding it");
+            return false;
+        }
+
+        t_entries entries;
+        entries.reserve(nb_entries);
+        for (std::uint32_t idx = 0; idx < nb_entries; ++idx)
+        {
+            std::uint16_t ticker_size = 0;
+            entry         cur_entry{};
+            if (not read_pod(ifs, ticker_size))
+            {
+                return false;
+            }
+            std::string ticker(ticker_size, '\0');
+            ifs.read(ticker.data(), ticker_size);
+            if (not read_pod(ifs, cur_entry.offset) || not read_pod(ifs, cur_entry.length) || cur_entry.offset + cur_entry.length > size)
+            {
+                return false;
+            }
+            entries.emplace(std::move(ticker), cur_entry);
+        }
+        m_entries = std::move(entries);
+        return true;
+    }
+
+    void
+    raw_mm2_coins_index::build_index(std::int64_t mtime, std::uint64_t size) const noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        std::ifstream ifs(m_coins_path.string(), std::ios::binary);
+        if (not ifs.is_open())
+        {
+            spdlog::error("cannot open the mm2 coins file: {}", m_coins_path.string());
+            return;
+        }
+        const std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+        m_entries.clear();
+        for (auto&& [offset, length]: scan_top_level_objects(content))
+        {
+            coin_name_sax sax;
+            nlohmann::json::sax_parse(content.begin() + offset, content.begin() + offset + length, &sax);
+            if (not sax.m_coin.empty())
+            {
+                m_entries.emplace(std::move(sax.m_coin), entry{.offset = offset, .length = length});
+            }
+        }
+        spdlog::info("indexed {} coins of {}", m_entries.size(), m_coins_path.string());
+
+        //! The index is only a cache, the coins stay available if it can't be written
+        const fs::path tmp_path = fs::path(m_index_path).replace_extension(".tmp");
+        {
+            std::ofstream ofs(tmp_path.string(), std::ios::binary | std::ios::trunc);
+            if (not ofs.is_open())
+            {
+                spdlog::warn("cannot write the mm2 coins index: {}", tmp_path.string());
+                return;
+            }
+            ofs.write(g_coins_index_magic.data(), g_coins_index_magic.size());
+            write_pod(ofs, g_coins_index_version);
+            write_pod(ofs, mtime);
+            write_pod(ofs, size);
+            write_pod(ofs, static_cast<std::uint32_t>(m_entries.size()));
+            for (auto&& [ticker, cur_entry]: m_entries)
+            {
+                write_pod(ofs, static_cast<std::uint16_t>(ticker.size()));
+                ofs.write(ticker.data(), ticker.size());
+                write_pod(ofs, cur_entry.offset);
+                write_pod(ofs, cur_entry.length);
+            }
+        }
+
+        boost::system::error_code ec;
+        fs::rename(tmp_path, m_index_path, ec);
+        if (ec)
+        {
+            spdlog::warn("cannot write the mm2 coins index: {}", ec.message());
+            fs::remove(tmp_path, ec);
+        }
+    }
+
+    std::optional<coin_element>
+    raw_mm2_coins_index::get(const std::string& ticker) const noexcept
+    {
+        std::scoped_lock lock(m_index_mutex);
+        load();
+
+        if (auto it = m_decoded.find(ticker); it != m_decoded.end())
+        {
+            return it->second;
+        }
+
+        const auto entry_it = m_entries.find(ticker);
+        if (entry_it == m_entries.end())
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            std::ifstream ifs(m_coins_path.string(), std::ios::binary);
+            std::string   raw(entry_it->second.length, '\0');
+            ifs.seekg(entry_it->second.offset);
+            ifs.read(raw.data(), raw.size());
+            if (not ifs.good())
+            {
+                spdlog::error("cannot read {} from the mm2 coins file", ticker);
+                return std::nullopt;
+            }
+            auto element = nlohmann::json::parse(raw).get<coin_element>();
+            return m_decoded.emplace(ticker, std::move(element)).first->second;
+        }
+        catch (const std::exception& error)
+        {
+            spdlog::error("cannot decode {} from the mm2 coins file: {}", ticker, error.what());
+            return std::nullopt;
+        }
+    }
+
+    std::size_t
+    raw_mm2_coins_index::get_nb_coins() const noexcept
+    {
+        std::scoped_lock lock(m_index_mutex);
+        load();
+        return m_entries.size();
+    }
+
+    std::size_t
+    raw_mm2_coins_index::get_nb_decoded_coins() const noexcept
+    {
+        std::scoped_lock lock(m_index_mutex);
+        return m_decoded.size();
+    }
+} // namespace atomic_dex
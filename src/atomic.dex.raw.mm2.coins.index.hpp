@@ -0,0 +1,58 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include "atomic.dex.pch.hpp"
+#include "atomic.dex.raw.mm2.coins.cfg.hpp"
+
+namespace atomic_dex
+{
+    //! Byte range of every coin of the mm2 coins file, persisted next to the other caches and rebuilt only when the file changes
+    //! A coin is decoded from its own range the first time it is asked, the rest of the file is never parsed
+    class raw_mm2_coins_index
+    {
+        struct entry
+        {
+            std::uint64_t offset;
+            std::uint64_t length;
+        };
+
+        using t_entries = std::unordered_map<std::string, entry>;
+
+        fs::path                                              m_coins_path;
+        fs::path                                              m_index_path;
+        mutable std::mutex                                    m_index_mutex;
+        mutable bool                                          m_loaded{false};
+        mutable t_entries                                     m_entries;
+        mutable std::unordered_map<std::string, coin_element> m_decoded;
+
+        //! Private API, m_index_mutex must be held
+        void load() const noexcept;
+        bool read_index(std::int64_t mtime, std::uint64_t size) const noexcept;
+        void build_index(std::int64_t mtime, std::uint64_t size) const noexcept;
+
+      public:
+        //! Constructor, nothing is read before the first lookup
+        raw_mm2_coins_index(fs::path coins_path, fs::path index_path) noexcept;
+
+        //! Decoded configuration of the coin, std::nullopt if the coins file doesn't know it
+        [[nodiscard]] std::optional<coin_element> get(const std::string& ticker) const noexcept;
+
+        [[nodiscard]] std::size_t get_nb_coins() const noexcept;
+        [[nodiscard]] std::size_t get_nb_decoded_coins() const noexcept;
+    };
+} // namespace atomic_dex
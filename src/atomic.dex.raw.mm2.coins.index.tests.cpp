@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.raw.mm2.coins.index.hpp"
+#include <doctest/doctest.h>
+
+namespace
+{
+    void
+    write_coins_file(const fs::path& path, const std::string& content)
+    {
+        std::ofstream ofs(path.string(), std::ios::trunc);
+        ofs << content;
+    }
+} // namespace
+
+SCENARIO("atomic dex raw mm2 coins index")
+{
+    GIVEN("A coins file with braces and escaped quotes inside the values")
+    {
+        const fs::path folder = fs::temp_directory_path() / fs::unique_path();
+        fs::create_directories(folder);
+        const fs::path coins_path = folder / "coins";
+        const fs::path index_path = folder / "mm2-coins.idx";
+        write_coins_file(coins_path, R"([
+          {"coin":"KMD","fname":"Komodo {main} \"chain\"","rpcport":7771,"txversion":4,"mm2":1},
+          {"fname":"[ethereum]","coin":"ETH","rpcport":80,"protocol":{"type":"ETH"}},
+          {"coin":"RICK","asset":"RICK","rpcport":25435,"address_format":{"format":"standard"}}
+        ])");
+
+        WHEN("I look up a coin")
+        {
+            atomic_dex::raw_mm2_coins_index index(coins_path, index_path);
+            auto                            kmd = index.get("KMD");
+
+            THEN("only this coin is decoded and the index is persisted")
+            {
+                REQUIRE(kmd.has_value());
+                CHECK_EQ(kmd->coin, "KMD");
+                CHECK_EQ(kmd->rpcport, 7771);
+                CHECK_EQ(index.get_nb_coins(), 3);
+                CHECK_EQ(index.get_nb_decoded_coins(), 1);
+                CHECK(fs::exists(index_path));
+                CHECK_FALSE(index.get("BTC").has_value());
+            }
+
+            AND_THEN("a new index reuses the persisted one")
+            {
+                const auto                      index_mtime = fs::last_write_time(index_path);
+                atomic_dex::raw_mm2_coins_index other(coins_path, index_path);
+                REQUIRE(other.get("ETH").has_value());
+                CHECK_EQ(other.get("ETH")->rpcport, 80);
+                CHECK_EQ(fs::last_write_time(index_path), index_mtime);
+            }
+        }
+
+        WHEN("the coins file changes")
+        {
+            atomic_dex::raw_mm2_coins_index index(coins_path, index_path);
+            CHECK_EQ(index.get_nb_coins(), 3);
+            write_coins_file(coins_path, R"([{"coin":"MORTY","rpcport":16348}])");
+
+            THEN("the index is rebuilt")
+            {
+                atomic_dex::raw_mm2_coins_index other(coins_path, index_path);
+                CHECK_EQ(other.get_nb_coins(), 1);
+                REQUIRE(other.get("MORTY").has_value());
+                CHECK_FALSE(other.get("KMD").has_value());
+            }
+        }
+        fs::remove_all(folder);
+    }
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+//! Project Headers
+#include "atomic.dex.startup.tracer.hpp"
+
+namespace
+{
+    std::int64_t
+    to_microseconds(atomic_dex::startup_tracer::t_clock::duration duration) noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    }
+} // namespace
+
+namespace atomic_dex
+{
+    void
+    startup_tracer::begin_session() noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+
+        std::scoped_lock lock(m_spans_mutex);
+        m_spans.clear();
+        m_thread_ids.clear();
+        m_session_start = t_clock::now();
+        m_recording     = true;
+    }
+
+    bool
+    startup_tracer::is_recording() const noexcept
+    {
+        return m_recording.load();
+    }
+
+    void
+    startup_tracer::record(std::string name, std::string category, t_clock::time_point start, t_clock::time_point end) noexcept
+    {
+        if (not m_recording.load())
+        {
+            return;
+        }
+
+        std::scoped_lock lock(m_spans_mutex);
+        const auto       thread_id = m_thread_ids.emplace(std::this_thread::get_id(), m_thread_ids.size()).first->second;
+        m_spans.push_back(span{.name = std::move(name), .category = std::move(category), .start = start, .end = end, .thread_id = thread_id});
+    }
+
+    nlohmann::json
+    startup_tracer::to_json() const
+    {
+        std::scoped_lock lock(m_spans_mutex);
+        nlohmann::json   events = nlohmann::json::array();
+        for (auto&& cur: m_spans)
+        {
+            //! Complete events, a span that started before the session is clamped to its start
+            const auto start = std::max(cur.start, m_session_start);
+            events.push_back(
+                {{"name", cur.name},
+                 {"cat", cur.category},
+                 {"ph", "X"},
+                 {"ts", to_microseconds(start - m_session_start)},
+                 {"dur", to_microseconds(cur.end - start)},
+                 {"pid", 1},
+                 {"tid", cur.thread_id}});
+        }
+        return {{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+    }
+
+    bool
+    startup_tracer::end_session(const fs::path& path) noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        if (not m_recording.load())
+        {
+            return false;
+        }
+
+        record("startup", "startup", m_session_start, t_clock::now());
+        m_recording = false;
+
+        try
+        {
+            const auto    trace = to_json();
+            std::ofstream ofs(path.string(), std::ios::trunc);
+            if (not ofs.is_open())
+            {
+                spdlog::error("cannot write the startup trace: {}", path.string());
+                return false;
+            }
+            ofs << trace.dump();
+            spdlog::info("startup trace written to {} ({} spans)", path.string(), trace.at("traceEvents").size());
+            return ofs.good();
+        }
+        catch (const std::exception& error)
+        {
+            spdlog::error("cannot write the startup trace: {}", error.what());
+            return false;
+        }
+    }
+
+    startup_tracer&
+    get_startup_tracer() noexcept
+    {
+        static startup_tracer tracer;
+        return tracer;
+    }
+
+    startup_span::startup_span(std::string name, std::string category) noexcept : m_name(std::move(name)), m_category(std::move(category))
+    {
+    }
+
+    startup_span::~startup_span() noexcept
+    {
+        get_startup_tracer().record(std::move(m_name), std::move(m_category), m_start, startup_tracer::t_clock::now());
+    }
+} // namespace atomic_dex
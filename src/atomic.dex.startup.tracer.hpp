@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include "atomic.dex.pch.hpp"
+
+namespace atomic_dex
+{
+    //! Named spans of a login (password derivation, mm2 spawn, coins activation...) written as a chrome trace
+    //! The file can be opened with chrome://tracing or ui.perfetto.dev to compare the cold start of two releases
+    class startup_tracer
+    {
+      public:
+        using t_clock = std::chrono::steady_clock;
+
+      private:
+        struct span
+        {
+            std::string         name;
+            std::string         category;
+            t_clock::time_point start;
+            t_clock::time_point end;
+            std::size_t         thread_id;
+        };
+
+        mutable std::mutex                               m_spans_mutex;
+        std::atomic_bool                                 m_recording{false};
+        t_clock::time_point                              m_session_start;
+        std::vector<span>                                m_spans;
+        std::unordered_map<std::thread::id, std::size_t> m_thread_ids; ///< small ids in order of appearance, the main thread is usually 0
+
+      public:
+        //! Start a new session, the spans of the previous one are dropped
+        void begin_session() noexcept;
+
+        [[nodiscard]] bool is_recording() const noexcept;
+
+        //! Ignored outside of a session
+        void record(std::string name, std::string category, t_clock::time_point start, t_clock::time_point end) noexcept;
+
+        //! Chrome trace of the current session, timestamps are in microseconds from the session start
+        [[nodiscard]] nlohmann::json to_json() const;
+
+        //! Record a span covering the whole session, write it to path and stop recording
+        bool end_session(const fs::path& path) noexcept;
+    };
+
+    startup_tracer& get_startup_tracer() noexcept;
+
+    //! Record a span from its construction to its destruction
+    class startup_span
+    {
+        std::string                         m_name;
+        std::string                         m_category;
+        startup_tracer::t_clock::time_point m_start{startup_tracer::t_clock::now()};
+
+      public:
+        explicit startup_span(std::string name, std::string category = "startup") noexcept;
+        ~startup_span() noexcept;
+
+        startup_span(const startup_span&) = delete;
+        startup_span& operator=(const startup_span&) = delete;
+    };
+} // namespace atomic_dex
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.startup.tracer.hpp"
+#include <doctest/doctest.h>
+
+TEST_CASE("atomic dex startup tracer")
+{
+    atomic_dex::startup_tracer tracer;
+    const auto                 now = atomic_dex::startup_tracer::t_clock::now();
+
+    //! Nothing is recorded outside of a session
+    tracer.record("ignored", "test", now, now);
+    CHECK_FALSE(tracer.is_recording());
+    CHECK(tracer.to_json().at("traceEvents").empty());
+
+    tracer.begin_session();
+    const auto start = atomic_dex::startup_tracer::t_clock::now();
+    tracer.record("derive_password", "startup", start, start + std::chrono::milliseconds(250));
+    std::thread([&tracer, start]() { tracer.record("process_balance KMD", "mm2", start, start + std::chrono::milliseconds(20)); }).join();
+
+    const auto trace = tracer.to_json();
+    REQUIRE_EQ(trace.at("traceEvents").size(), 2);
+    const auto& first = trace.at("traceEvents").at(0);
+    CHECK_EQ(first.at("name").get<std::string>(), "derive_password");
+    CHECK_EQ(first.at("ph").get<std::string>(), "X");
+    CHECK_EQ(first.at("dur").get<std::int64_t>(), 250000);
+    CHECK_EQ(first.at("tid").get<std::size_t>(), 0);
+    CHECK_EQ(trace.at("traceEvents").at(1).at("tid").get<std::size_t>(), 1);
+
+    const fs::path trace_path = fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.startup.json");
+    CHECK(tracer.end_session(trace_path));
+    CHECK_FALSE(tracer.is_recording());
+
+    std::ifstream  ifs(trace_path.string());
+    nlohmann::json written;
+    ifs >> written;
+    CHECK_EQ(written.at("traceEvents").size(), 3);
+    CHECK_EQ(written.at("traceEvents").back().at("name").get<std::string>(), "startup");
+    CHECK_FALSE(tracer.end_session(trace_path));
+    fs::remove(trace_path);
+}
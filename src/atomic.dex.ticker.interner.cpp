@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+//! Project Headers
+#include "atomic.dex.ticker.interner.hpp"
+
+namespace atomic_dex
+{
+    t_ticker_id
+    ticker_interner::intern(std::string_view ticker)
+    {
+        if (const auto id = find(ticker); id != g_invalid_ticker_id)
+        {
+            return id;
+        }
+
+        std::unique_lock lock(m_interner_mutex);
+        if (auto it = m_ids.find(ticker); it != m_ids.end())
+        {
+            return it->second;
+        }
+        if (m_tickers.size() >= g_invalid_ticker_id)
+        {
+            spdlog::error("cannot intern {}, every ticker id is taken", ticker);
+            return g_invalid_ticker_id;
+        }
+
+        const auto         id     = static_cast<t_ticker_id>(m_tickers.size());
+        const std::string& stored = m_tickers.emplace_back(ticker);
+        m_ids.emplace(stored, id);
+        return id;
+    }
+
+    t_ticker_id
+    ticker_interner::find(std::string_view ticker) const noexcept
+    {
+        std::shared_lock lock(m_interner_mutex);
+        const auto       it = m_ids.find(ticker);
+        return it != m_ids.end() ? it->second : g_invalid_ticker_id;
+    }
+
+    const std::string&
+    ticker_interner::get_ticker(t_ticker_id id) const
+    {
+        std::shared_lock lock(m_interner_mutex);
+        return m_tickers.at(id);
+    }
+
+    std::size_t
+    ticker_interner::size() const noexcept
+    {
+        std::shared_lock lock(m_interner_mutex);
+        return m_tickers.size();
+    }
+
+    ticker_interner&
+    get_ticker_interner() noexcept
+    {
+        static ticker_interner interner;
+        return interner;
+    }
+} // namespace atomic_dex
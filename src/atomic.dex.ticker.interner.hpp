@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+//! STD Headers
+#include <deque>
+#include <shared_mutex>
+#include <string_view>
+
+//! PCH Headers
+#include "atomic.dex.pch.hpp"
+
+namespace atomic_dex
+{
+    using t_ticker_id = std::uint16_t;
+
+    constexpr t_ticker_id g_invalid_ticker_id = std::numeric_limits<t_ticker_id>::max();
+
+    //! Process wide mapping between a ticker and a dense id, ids are never reused so they can index flat arrays
+    class ticker_interner
+    {
+        mutable folly::SharedMutex                        m_interner_mutex;
+        std::deque<std::string>                           m_tickers; ///< stable storage, the keys of m_ids point into it
+        std::unordered_map<std::string_view, t_ticker_id> m_ids;
+
+      public:
+        //! Id of the ticker, a new one is allocated the first time, g_invalid_ticker_id once every id is taken
+        t_ticker_id intern(std::string_view ticker);
+
+        //! Id of an already interned ticker, g_invalid_ticker_id otherwise
+        [[nodiscard]] t_ticker_id find(std::string_view ticker) const noexcept;
+
+        //! The reference stays valid for the lifetime of the process
+        [[nodiscard]] const std::string& get_ticker(t_ticker_id id) const;
+
+        //! Upper bound of the ids handed out so far, the size of the arrays indexed by id
+        [[nodiscard]] std::size_t size() const noexcept;
+    };
+
+    ticker_interner& get_ticker_interner() noexcept;
+} // namespace atomic_dex
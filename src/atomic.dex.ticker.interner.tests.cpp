@@ -0,0 +1,44 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.ticker.interner.hpp"
+#include <doctest/doctest.h>
+
+TEST_CASE("atomic dex ticker interner")
+{
+    atomic_dex::ticker_interner interner;
+    CHECK_EQ(interner.find("KMD"), atomic_dex::g_invalid_ticker_id);
+
+    const auto kmd_id = interner.intern("KMD");
+    const auto btc_id = interner.intern("BTC");
+    CHECK_EQ(kmd_id, 0);
+    CHECK_EQ(btc_id, 1);
+    CHECK_EQ(interner.intern(std::string("KMD")), kmd_id);
+    CHECK_EQ(interner.find("BTC"), btc_id);
+    CHECK_EQ(interner.get_ticker(btc_id), "BTC");
+    CHECK_EQ(interner.size(), 2);
+
+    //! Interning from several threads gives a single id per ticker
+    std::vector<std::future<atomic_dex::t_ticker_id>> futures;
+    for (std::size_t idx = 0; idx < 8; ++idx)
+    {
+        futures.push_back(std::async(std::launch::async, [&interner]() { return interner.intern("RICK"); }));
+    }
+    std::set<atomic_dex::t_ticker_id> rick_ids;
+    for (auto&& fut: futures) { rick_ids.insert(fut.get()); }
+    CHECK_EQ(rick_ids.size(), 1);
+    CHECK_EQ(interner.size(), 3);
+}
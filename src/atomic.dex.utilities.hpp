@@ -73,6 +73,13 @@ get_atomic_dex_current_log_file()
     return log_path;
 }
 
+inline fs::path
+get_atomic_dex_current_startup_trace_file()
+{
+    //! Same name as the log file of the session, can be opened with chrome://tracing or ui.perfetto.dev
+    return fs::path(get_atomic_dex_current_log_file()).replace_extension(".startup.json");
+}
+
 inline fs::path
 get_atomic_dex_config_folder()
 {
@@ -105,6 +112,36 @@ get_atomic_dex_export_folder()
     return get_atomic_dex_data_folder() / "exports";
 }
 
+inline fs::path
+get_atomic_dex_ohlc_cache_folder()
+{
+    if (not fs::exists(get_atomic_dex_data_folder() / "ohlc"))
+    {
+        fs::create_directories(get_atomic_dex_data_folder() / "ohlc");
+    }
+    return get_atomic_dex_data_folder() / "ohlc";
+}
+
+inline fs::path
+get_atomic_dex_raw_coins_index_file()
+{
+    if (not fs::exists(get_atomic_dex_data_folder()))
+    {
+        fs::create_directories(get_atomic_dex_data_folder());
+    }
+    return get_atomic_dex_data_folder() / "mm2-coins.idx";
+}
+
+inline fs::path
+get_atomic_dex_electrum_scores_file()
+{
+    if (not fs::exists(get_atomic_dex_data_folder()))
+    {
+        fs::create_directories(get_atomic_dex_data_folder());
+    }
+    return get_atomic_dex_data_folder() / "electrum-scores.json";
+}
+
 inline fs::path
 get_atomic_dex_current_export_recent_swaps_file()
 {
@@ -178,87 +215,3 @@ struct timed_waiter
     mutable std::condition_variable cv;
     bool                            interrupted = false;
 };
-
-
-namespace atomic_dex::utils
-{
-    struct my_json_sax : nlohmann::json_sax<nlohmann::json>
-    {
-        bool
-        null() override
-        {
-            return true;
-        }
-
-        bool
-        boolean([[maybe_unused]] bool val) override
-        {
-            return true;
-        }
-
-        bool
-        number_integer([[maybe_unused]] number_integer_t val) override
-        {
-            return true;
-        };
-
-        bool
-        number_unsigned([[maybe_unused]] number_unsigned_t val) override
-        {
-            return true;
-        };
-
-        bool
-        number_float([[maybe_unused]] number_float_t val, [[maybe_unused]] const string_t& s) override
-        {
-            this->float_as_string = s;
-            return true;
-        }
-
-        bool
-        string([[maybe_unused]] string_t& val) override
-        {
-            return true;
-        }
-
-        bool
-        start_object([[maybe_unused]] std::size_t elements) override
-        {
-            return true;
-        }
-
-        bool
-        key([[maybe_unused]] string_t& val) override
-        {
-            return true;
-        }
-
-        bool
-        end_object() override
-        {
-            return true;
-        }
-
-        bool
-        start_array([[maybe_unused]] std::size_t elements) override
-        {
-            return true;
-        }
-
-        bool
-        end_array() override
-        {
-            return true;
-        }
-
-        bool
-        parse_error(
-            [[maybe_unused]] std::size_t position, [[maybe_unused]] const std::string& last_token,
-            [[maybe_unused]] const nlohmann::detail::exception& ex) override
-        {
-            return false;
-        };
-
-        std::string float_as_string;
-    };
-} // namespace atomic_dex::utils
\ No newline at end of file
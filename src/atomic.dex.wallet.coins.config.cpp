@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+//! Project Headers
+#include "atomic.dex.wallet.coins.config.hpp"
+
+namespace atomic_dex
+{
+    wallet_coins_config::wallet_coins_config(std::chrono::milliseconds debounce) : m_debounce(debounce)
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        m_flusher_thread = std::thread([this]() { flusher_loop(); });
+    }
+
+    wallet_coins_config::~wallet_coins_config() noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        {
+            std::scoped_lock lock(m_config_mutex);
+            m_stopping = true;
+        }
+        m_config_cv.notify_all();
+        if (m_flusher_thread.joinable())
+        {
+            m_flusher_thread.join();
+        }
+        persist();
+    }
+
+    void
+    wallet_coins_config::flusher_loop() noexcept
+    {
+        std::unique_lock lock(m_config_mutex);
+        while (not m_stopping)
+        {
+            m_config_cv.wait(lock, [this]() { return m_dirty || m_stopping; });
+
+            //! Let the next toggles of the burst land before writing
+            if (m_config_cv.wait_for(lock, m_debounce, [this]() { return m_stopping; }))
+            {
+                break;
+            }
+
+            lock.unlock();
+            persist();
+            lock.lock();
+        }
+    }
+
+    void
+    wallet_coins_config::persist() noexcept
+    {
+        std::scoped_lock write_lock(m_write_mutex);
+        fs::path         path;
+        nlohmann::json   snapshot;
+        {
+            std::scoped_lock lock(m_config_mutex);
+            if (not m_dirty)
+            {
+                return;
+            }
+            m_dirty  = false;
+            path     = m_path;
+            snapshot = m_config;
+        }
+
+        if (write_atomically(path, snapshot))
+        {
+            ++m_nb_writes;
+        }
+    }
+
+    bool
+    wallet_coins_config::write_atomically(const fs::path& path, const nlohmann::json& config) noexcept
+    {
+        const fs::path tmp_path = fs::path(path).replace_extension(".tmp");
+        {
+            std::ofstream ofs(tmp_path.string(), std::ios::trunc);
+            if (not ofs.is_open())
+            {
+                spdlog::error("cannot write wallet coins config: {}", tmp_path.string());
+                return false;
+            }
+            ofs << config;
+            ofs.flush();
+            if (not ofs.good())
+            {
+                spdlog::error("cannot write wallet coins config: {}", tmp_path.string());
+                return false;
+            }
+        }
+
+        boost::system::error_code ec;
+        fs::rename(tmp_path, path, ec);
+        if (ec)
+        {
+            spdlog::error("error: {}", ec.message());
+            fs::remove(tmp_path, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool
+    wallet_coins_config::load(fs::path path) noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        persist();
+
+        nlohmann::json config;
+        try
+        {
+            std::ifstream ifs(path.string());
+            if (not ifs.is_open())
+            {
+                return false;
+            }
+            ifs >> config;
+        }
+        catch (const std::exception& error)
+        {
+            spdlog::error("cannot parse wallet coins config {}: {}", path.string(), error.what());
+            return false;
+        }
+
+        std::scoped_lock lock(m_config_mutex);
+        m_path   = std::move(path);
+        m_config = std::move(config);
+        m_dirty  = false;
+        return true;
+    }
+
+    nlohmann::json
+    wallet_coins_config::get_config() const noexcept
+    {
+        std::scoped_lock lock(m_config_mutex);
+        return m_config;
+    }
+
+    void
+    wallet_coins_config::set_active(const std::vector<std::string>& tickers, bool status) noexcept
+    {
+        {
+            std::scoped_lock lock(m_config_mutex);
+            for (auto&& ticker: tickers)
+            {
+                if (auto it = m_config.find(ticker); it != m_config.end())
+                {
+                    (*it)["active"] = status;
+                    m_dirty         = true;
+                }
+                else
+                {
+                    spdlog::warn("{} is not part of the wallet coins config", ticker);
+                }
+            }
+        }
+        m_config_cv.notify_one();
+    }
+
+    void
+    wallet_coins_config::flush() noexcept
+    {
+        persist();
+    }
+
+    std::size_t
+    wallet_coins_config::get_nb_writes() const noexcept
+    {
+        return m_nb_writes.load();
+    }
+} // namespace atomic_dex
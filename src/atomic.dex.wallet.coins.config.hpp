@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include "atomic.dex.pch.hpp"
+
+namespace atomic_dex
+{
+    //! In memory copy of <version>-coins.<wallet>.json, authoritative once loaded
+    //! Changes are written behind by a flusher thread, a burst of toggles is coalesced into a single atomic rewrite of the file
+    class wallet_coins_config
+    {
+        fs::path                  m_path;
+        nlohmann::json            m_config{nlohmann::json::object()};
+        std::chrono::milliseconds m_debounce;
+        bool                      m_dirty{false};
+        bool                      m_stopping{false};
+        std::atomic<std::size_t>  m_nb_writes{0};
+        mutable std::mutex        m_config_mutex;
+        std::mutex                m_write_mutex; ///< serialize the writes, the file always ends with the latest snapshot
+        std::condition_variable   m_config_cv;
+        std::thread               m_flusher_thread;
+
+        //! Private API
+        void persist() noexcept;
+        void flusher_loop() noexcept;
+
+      public:
+        //! Constructor, start the flusher
+        explicit wallet_coins_config(std::chrono::milliseconds debounce = std::chrono::milliseconds(500));
+
+        //! Destructor, pending changes are flushed
+        ~wallet_coins_config() noexcept;
+
+        wallet_coins_config(const wallet_coins_config&) = delete;
+        wallet_coins_config& operator=(const wallet_coins_config&) = delete;
+
+        //! Flush the current file and load another one, return false if the file cannot be read
+        bool load(fs::path path) noexcept;
+
+        //! Copy of the in memory configuration
+        [[nodiscard]] nlohmann::json get_config() const noexcept;
+
+        //! Mark the coins as active / inactive, the file is written at most once per debounce window
+        void set_active(const std::vector<std::string>& tickers, bool status) noexcept;
+
+        //! Write the pending changes now
+        void flush() noexcept;
+
+        [[nodiscard]] std::size_t get_nb_writes() const noexcept;
+
+        //! Temp file + rename, a crash in the middle of the write leaves the previous file intact
+        static bool write_atomically(const fs::path& path, const nlohmann::json& config) noexcept;
+    };
+} // namespace atomic_dex
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.wallet.coins.config.hpp"
+#include <doctest/doctest.h>
+
+SCENARIO("atomic dex wallet coins config")
+{
+    GIVEN("A wallet coins config file")
+    {
+        using namespace std::chrono_literals;
+        const fs::path folder = fs::temp_directory_path() / fs::unique_path();
+        fs::create_directories(folder);
+        const fs::path cfg_path = folder / "0.1.0-coins.wallet.json";
+        REQUIRE(atomic_dex::wallet_coins_config::write_atomically(
+            cfg_path, R"({"KMD":{"coin":"KMD","active":true},"BTC":{"coin":"BTC","active":false},"RICK":{"coin":"RICK","active":false}})"_json));
+
+        auto read_file = [&cfg_path]() {
+            std::ifstream  ifs(cfg_path.string());
+            nlohmann::json j;
+            ifs >> j;
+            return j;
+        };
+
+        WHEN("I toggle several coins in a burst")
+        {
+            {
+                //! The window outlasts the test, only flush() writes the file
+                atomic_dex::wallet_coins_config cfg(1h);
+                REQUIRE(cfg.load(cfg_path));
+                cfg.set_active({"BTC"}, true);
+                cfg.set_active({"RICK"}, true);
+                cfg.set_active({"KMD"}, false);
+                cfg.set_active({"UNKNOWN"}, true);
+
+                THEN("the in memory config is updated immediately and the file is written once")
+                {
+                    CHECK(cfg.get_config().at("BTC").at("active").get<bool>());
+                    CHECK_FALSE(cfg.get_config().contains("UNKNOWN"));
+                    CHECK_EQ(cfg.get_nb_writes(), 0);
+                    CHECK(read_file().at("KMD").at("active").get<bool>());
+
+                    cfg.flush();
+                    CHECK_EQ(cfg.get_nb_writes(), 1);
+                    CHECK_FALSE(read_file().at("KMD").at("active").get<bool>());
+                    CHECK(read_file().at("RICK").at("active").get<bool>());
+                    CHECK_FALSE(fs::exists(fs::path(cfg_path).replace_extension(".tmp")));
+
+                    //! Nothing left to write
+                    cfg.flush();
+                    CHECK_EQ(cfg.get_nb_writes(), 1);
+                }
+            }
+        }
+
+        WHEN("the config is destroyed before the end of the debounce window")
+        {
+            {
+                atomic_dex::wallet_coins_config cfg(10s);
+                REQUIRE(cfg.load(cfg_path));
+                cfg.set_active({"BTC"}, true);
+                CHECK_EQ(cfg.get_nb_writes(), 0);
+            }
+
+            THEN("the pending changes are flushed")
+            {
+                CHECK(read_file().at("BTC").at("active").get<bool>());
+            }
+        }
+        fs::remove_all(folder);
+    }
+}
@@ -58,6 +58,24 @@ namespace atomic_dex
         j["addresses"] = cfg.contents;
     }
 
+    bool
+    operator==(const contact_contents& lhs, const contact_contents& rhs) noexcept
+    {
+        return lhs.type == rhs.type && lhs.address == rhs.address;
+    }
+
+    bool
+    operator==(const contact& lhs, const contact& rhs) noexcept
+    {
+        return lhs.name == rhs.name && lhs.contents == rhs.contents;
+    }
+
+    bool
+    operator!=(const contact& lhs, const contact& rhs) noexcept
+    {
+        return not(lhs == rhs);
+    }
+
     void
     to_json(nlohmann::json& j, const wallet_cfg& cfg)
     {
@@ -27,6 +27,7 @@ namespace atomic_dex
     };
 
     void to_json(nlohmann::json& j, const contact_contents& cfg);
+    bool operator==(const contact_contents& lhs, const contact_contents& rhs) noexcept;
 
     struct contact
     {
@@ -35,6 +36,8 @@ namespace atomic_dex
     };
 
     void to_json(nlohmann::json& j, const contact& cfg);
+    bool operator==(const contact& lhs, const contact& rhs) noexcept;
+    bool operator!=(const contact& lhs, const contact& rhs) noexcept;
 
     struct wallet_cfg
     {
@@ -0,0 +1,448 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+//! Project Headers
+#include "atomic.dex.wallet.config.store.hpp"
+
+namespace
+{
+    constexpr std::array<char, 4> g_wallet_cfg_magic{'W', 'C', 'F', 'G'};
+    constexpr std::uint32_t       g_wallet_cfg_version     = 1;
+    constexpr std::size_t         g_wallet_cfg_header_size = g_wallet_cfg_magic.size() + sizeof(g_wallet_cfg_version);
+
+    //! Every record is [type: u8][payload size: u32][payload]
+    enum class record_type : std::uint8_t
+    {
+        snapshot            = 1, ///< whole configuration
+        set_protection_pass = 2,
+        set_contact         = 3, ///< replace (or append) the contact at an index
+        erase_contact       = 4, ///< erase the contact at an index
+        resize_contacts     = 5
+    };
+
+    void
+    put_u32(std::string& buffer, std::uint32_t value)
+    {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void
+    put_string(std::string& buffer, const std::string& value)
+    {
+        put_u32(buffer, static_cast<std::uint32_t>(value.size()));
+        buffer.append(value);
+    }
+
+    void
+    put_contact(std::string& buffer, const atomic_dex::contact& value)
+    {
+        put_string(buffer, value.name);
+        put_u32(buffer, static_cast<std::uint32_t>(value.contents.size()));
+        for (auto&& cur: value.contents)
+        {
+            put_string(buffer, cur.type);
+            put_string(buffer, cur.address);
+        }
+    }
+
+    void
+    put_record(std::string& buffer, record_type type, const std::string& payload)
+    {
+        buffer.push_back(static_cast<char>(type));
+        put_u32(buffer, static_cast<std::uint32_t>(payload.size()));
+        buffer.append(payload);
+    }
+
+    std::string
+    snapshot_record(const atomic_dex::wallet_cfg& cfg)
+    {
+        std::string payload;
+        put_string(payload, cfg.name);
+        put_string(payload, cfg.protection_pass);
+        put_u32(payload, static_cast<std::uint32_t>(cfg.address_book.size()));
+        for (auto&& cur: cfg.address_book) { put_contact(payload, cur); }
+
+        std::string record;
+        put_record(record, record_type::snapshot, payload);
+        return record;
+    }
+
+    //! Bounds checked reader over the content of the file, any read past the end marks the reader as failed
+    struct binary_reader
+    {
+        const std::string& buffer;
+        std::size_t        pos{0};
+        bool               failed{false};
+
+        std::uint32_t
+        u32()
+        {
+            std::uint32_t value = 0;
+            if (failed || buffer.size() - pos < sizeof(value))
+            {
+                failed = true;
+                return 0;
+            }
+            std::memcpy(&value, buffer.data() + pos, sizeof(value));
+            pos += sizeof(value);
+            return value;
+        }
+
+        std::string
+        string()
+        {
+            const auto size = u32();
+            if (failed || buffer.size() - pos < size)
+            {
+                failed = true;
+                return {};
+            }
+            std::string value = buffer.substr(pos, size);
+            pos += size;
+            return value;
+        }
+
+        atomic_dex::contact
+        contact()
+        {
+            atomic_dex::contact value{.name = string()};
+            const auto          nb_contents = u32();
+            for (std::uint32_t idx = 0; idx < nb_contents && not failed; ++idx)
+            {
+                auto type    = string();
+                auto address = string();
+                value.contents.push_back(atomic_dex::contact_contents{.type = std::move(type), .address = std::move(address)});
+            }
+            return value;
+        }
+    };
+
+    //! Every record is fully decoded before it touches cfg, a corrupt payload leaves the last good state untouched
+    bool
+    apply_record(record_type type, binary_reader& reader, atomic_dex::wallet_cfg& cfg)
+    {
+        switch (type)
+        {
+        case record_type::snapshot:
+        {
+            atomic_dex::wallet_cfg snapshot;
+            snapshot.name            = reader.string();
+            snapshot.protection_pass = reader.string();
+            const auto nb_contacts   = reader.u32();
+            for (std::uint32_t idx = 0; idx < nb_contacts && not reader.failed; ++idx) { snapshot.address_book.push_back(reader.contact()); }
+            if (reader.failed)
+            {
+                return false;
+            }
+            cfg = std::move(snapshot);
+            return true;
+        }
+        case record_type::set_protection_pass:
+        {
+            auto protection_pass = reader.string();
+            if (reader.failed)
+            {
+                return false;
+            }
+            cfg.protection_pass = std::move(protection_pass);
+            return true;
+        }
+        case record_type::set_contact:
+        {
+            const auto idx     = reader.u32();
+            auto       contact = reader.contact();
+            if (reader.failed || idx > cfg.address_book.size())
+            {
+                return false;
+            }
+            if (idx == cfg.address_book.size())
+            {
+                cfg.address_book.push_back(std::move(contact));
+            }
+            else
+            {
+                cfg.address_book[idx] = std::move(contact);
+            }
+            return true;
+        }
+        case record_type::erase_contact:
+        {
+            const auto idx = reader.u32();
+            if (reader.failed || idx >= cfg.address_book.size())
+            {
+                return false;
+            }
+            cfg.address_book.erase(cfg.address_book.begin() + idx);
+            return true;
+        }
+        case record_type::resize_contacts:
+        {
+            const auto size = reader.u32();
+            if (reader.failed || size > cfg.address_book.size())
+            {
+                return false;
+            }
+            cfg.address_book.resize(size);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    //! Records turning before into after, a single erase is detected so deleting a contact doesn't rewrite the following ones
+    std::size_t
+    diff_records(const atomic_dex::wallet_cfg& before, const atomic_dex::wallet_cfg& after, std::string& out)
+    {
+        std::size_t nb_records = 0;
+        std::string payload;
+        auto        push = [&](record_type type) {
+            put_record(out, type, payload);
+            payload.clear();
+            ++nb_records;
+        };
+
+        if (before.protection_pass != after.protection_pass)
+        {
+            put_string(payload, after.protection_pass);
+            push(record_type::set_protection_pass);
+        }
+
+        const auto& old_book = before.address_book;
+        const auto& new_book = after.address_book;
+        if (new_book.size() + 1 == old_book.size())
+        {
+            const auto mismatch = std::mismatch(new_book.begin(), new_book.end(), old_book.begin());
+            const auto idx      = static_cast<std::size_t>(std::distance(new_book.begin(), mismatch.first));
+            if (std::equal(new_book.begin() + idx, new_book.end(), old_book.begin() + idx + 1))
+            {
+                put_u32(payload, static_cast<std::uint32_t>(idx));
+                push(record_type::erase_contact);
+                return nb_records;
+            }
+        }
+
+        for (std::size_t idx = 0; idx < new_book.size(); ++idx)
+        {
+            if (idx >= old_book.size() || old_book[idx] != new_book[idx])
+            {
+                put_u32(payload, static_cast<std::uint32_t>(idx));
+                put_contact(payload, new_book[idx]);
+                push(record_type::set_contact);
+            }
+        }
+        if (new_book.size() < old_book.size())
+        {
+            put_u32(payload, static_cast<std::uint32_t>(new_book.size()));
+            push(record_type::resize_contacts);
+        }
+        return nb_records;
+    }
+} // namespace
+
+namespace atomic_dex
+{
+    wallet_cfg_store::wallet_cfg_store(std::size_t max_records) noexcept : m_max_records(max_records)
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+    }
+
+    std::optional<wallet_cfg>
+    wallet_cfg_store::load(fs::path path) noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        m_path             = std::move(path);
+        m_persisted        = wallet_cfg{};
+        m_nb_records       = 0;
+        m_needs_compaction = false;
+
+        std::ifstream ifs(m_path.string(), std::ios::binary);
+        if (not ifs.is_open())
+        {
+            return std::nullopt;
+        }
+        const std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+        std::array<char, 4> magic{};
+        std::uint32_t       version = 0;
+        if (content.size() < g_wallet_cfg_header_size)
+        {
+            return std::nullopt;
+        }
+        std::memcpy(magic.data(), content.data(), magic.size());
+        std::memcpy(&version, content.data() + magic.size(), sizeof(version));
+        if (magic != g_wallet_cfg_magic || version != g_wallet_cfg_version)
+        {
+            spdlog::error("{} has an unknown layout", m_path.string());
+            return std::nullopt;
+        }
+
+        binary_reader reader{.buffer = content, .pos = g_wallet_cfg_header_size};
+        while (reader.pos < content.size())
+        {
+            const auto type = static_cast<record_type>(content[reader.pos++]);
+            const auto size = reader.u32();
+            if (reader.failed || content.size() - reader.pos < size)
+            {
+                //! Torn trailing record (crash during an append), the next save rewrites the file
+                spdlog::warn("{} ends with an incomplete record, ignoring it", m_path.string());
+                m_needs_compaction = true;
+                break;
+            }
+
+            const std::string payload = content.substr(reader.pos, size);
+            reader.pos += size;
+            binary_reader payload_reader{.buffer = payload};
+            if (not apply_record(type, payload_reader, m_persisted))
+            {
+                spdlog::warn("{} contains an invalid record, ignoring the rest of the file", m_path.string());
+                m_needs_compaction = true;
+                break;
+            }
+            ++m_nb_records;
+        }
+
+        if (m_nb_records == 0)
+        {
+            return std::nullopt;
+        }
+        return m_persisted;
+    }
+
+    bool
+    wallet_cfg_store::append(const std::string& records, std::size_t nb_records) noexcept
+    {
+        std::ofstream ofs(m_path.string(), std::ios::binary | std::ios::app);
+        ofs.write(records.data(), records.size());
+        ofs.flush();
+        if (not ofs.good())
+        {
+            spdlog::error("cannot append to wallet config: {}", m_path.string());
+            return false;
+        }
+        m_nb_records += nb_records;
+        return true;
+    }
+
+    bool
+    wallet_cfg_store::save(const wallet_cfg& cfg) noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        if (m_nb_records == 0 || m_needs_compaction || cfg.name != m_persisted.name)
+        {
+            m_persisted = cfg;
+            return compact();
+        }
+
+        std::string records;
+        const auto  nb_records = diff_records(m_persisted, cfg, records);
+        if (nb_records == 0)
+        {
+            return true;
+        }
+        m_persisted = cfg;
+        if (m_nb_records + nb_records > m_max_records)
+        {
+            return compact();
+        }
+        return append(records, nb_records);
+    }
+
+    bool
+    wallet_cfg_store::compact() noexcept
+    {
+        spdlog::debug("{} l{} f[{}]", __FUNCTION__, __LINE__, fs::path(__FILE__).filename().string());
+        const fs::path tmp_path = fs::path(m_path).replace_extension(".tmp");
+        {
+            std::ofstream ofs(tmp_path.string(), std::ios::binary | std::ios::trunc);
+            const auto    record = snapshot_record(m_persisted);
+            ofs.write(g_wallet_cfg_magic.data(), g_wallet_cfg_magic.size());
+            ofs.write(reinterpret_cast<const char*>(&g_wallet_cfg_version), sizeof(g_wallet_cfg_version));
+            ofs.write(record.data(), record.size());
+            ofs.flush();
+            if (not ofs.good())
+            {
+                spdlog::error("cannot write wallet config: {}", tmp_path.string());
+                return false;
+            }
+        }
+
+        boost::system::error_code ec;
+        fs::rename(tmp_path, m_path, ec);
+        if (ec)
+        {
+            spdlog::error("error: {}", ec.message());
+            fs::remove(tmp_path, ec);
+            return false;
+        }
+        m_nb_records       = 1;
+        m_needs_compaction = false;
+        if (not m_export_path.empty())
+        {
+            export_json(m_persisted, m_export_path);
+        }
+        return true;
+    }
+
+    void
+    wallet_cfg_store::set_export_path(fs::path path) noexcept
+    {
+        m_export_path = std::move(path);
+    }
+
+    std::size_t
+    wallet_cfg_store::get_nb_records() const noexcept
+    {
+        return m_nb_records;
+    }
+
+    std::optional<wallet_cfg>
+    wallet_cfg_store::import_json(const fs::path& path) noexcept
+    {
+        std::ifstream ifs(path.string());
+        if (not ifs.is_open())
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            nlohmann::json j;
+            ifs >> j;
+            return j.get<wallet_cfg>();
+        }
+        catch (const std::exception& error)
+        {
+            spdlog::error("cannot import wallet config {}: {}", path.string(), error.what());
+            return std::nullopt;
+        }
+    }
+
+    bool
+    wallet_cfg_store::export_json(const wallet_cfg& cfg, const fs::path& path) noexcept
+    {
+        std::ofstream ofs(path.string(), std::ios::trunc);
+        if (not ofs.is_open())
+        {
+            return false;
+        }
+
+        nlohmann::json j;
+        atomic_dex::to_json(j, cfg);
+        ofs << j.dump(4);
+        return ofs.good();
+    }
+} // namespace atomic_dex
@@ -0,0 +1,61 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include "atomic.dex.pch.hpp"
+#include "atomic.dex.wallet.config.hpp"
+
+namespace atomic_dex
+{
+    //! Binary wallet configuration: <config_folder>/<wallet>.wallet.bin
+    //! A snapshot record followed by the change records appended by each save, replayed in order when loading
+    //! The file is compacted into a single snapshot once too many records were appended
+    class wallet_cfg_store
+    {
+        fs::path    m_path;
+        fs::path    m_export_path;
+        wallet_cfg  m_persisted;
+        std::size_t m_nb_records{0};
+        std::size_t m_max_records;
+        bool        m_needs_compaction{false};
+
+        //! Private API
+        bool append(const std::string& records, std::size_t nb_records) noexcept;
+
+      public:
+        //! Constructor
+        explicit wallet_cfg_store(std::size_t max_records = 64) noexcept;
+
+        //! Replay the records of a binary configuration, std::nullopt if the file is missing or not a wallet configuration
+        std::optional<wallet_cfg> load(fs::path path) noexcept;
+
+        //! Append the differences with the last saved configuration, the first save of a file writes a snapshot
+        bool save(const wallet_cfg& cfg) noexcept;
+
+        //! Rewrite the file as a single snapshot record, the json export is refreshed at the same time
+        bool compact() noexcept;
+
+        //! Json file written at every compaction so it never lags behind the binary snapshot, empty to disable
+        void set_export_path(fs::path path) noexcept;
+
+        [[nodiscard]] std::size_t get_nb_records() const noexcept;
+
+        //! Lossless conversion from / to the json layout of <wallet>.wallet.json
+        static std::optional<wallet_cfg> import_json(const fs::path& path) noexcept;
+        static bool                      export_json(const wallet_cfg& cfg, const fs::path& path) noexcept;
+    };
+} // namespace atomic_dex
@@ -0,0 +1,191 @@
+/******************************************************************************
+ * Copyright © 2013-2019 The Komodo Platform Developers.                      *
+ *                                                                            *
+ * See the AUTHORS, DEVELOPER-AGREEMENT and LICENSE files at                  *
+ * the top-level directory of this distribution for the individual copyright  *
+ * holder information and the developer policies on copyright and licensing.  *
+ *                                                                            *
+ * Unless otherwise agreed in a custom licensing agreement, no part of the    *
+ * Komodo Platform software, including this file may be copied, modified,     *
+ * propagated or distributed except according to the terms contained in the   *
+ * LICENSE file                                                               *
+ *                                                                            *
+ * Removal or modification of this copyright notice is prohibited.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "atomic.dex.wallet.config.store.hpp"
+#include <doctest/doctest.h>
+
+namespace
+{
+    atomic_dex::wallet_cfg
+    make_wallet_cfg(std::size_t nb_contacts)
+    {
+        atomic_dex::wallet_cfg cfg{.name = "roman"};
+        for (std::size_t idx = 0; idx < nb_contacts; ++idx)
+        {
+            atomic_dex::contact cur{.name = "contact-" + std::to_string(idx)};
+            cur.contents.push_back(atomic_dex::contact_contents{.type = "BTC", .address = "3FZbgi29cpjq2GjdwV8eyHuJJnkLtktZc5"});
+            cur.contents.push_back(atomic_dex::contact_contents{.type = "ERC-20", .address = "0xde0b295669a9fd93d5f28d9ec85e40f4cb697bae"});
+            cfg.address_book.push_back(std::move(cur));
+        }
+        return cfg;
+    }
+
+    std::string
+    read_file(const fs::path& path)
+    {
+        std::ifstream ifs(path.string(), std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    }
+
+    nlohmann::json
+    as_json(const atomic_dex::wallet_cfg& cfg)
+    {
+        nlohmann::json j;
+        atomic_dex::to_json(j, cfg);
+        return j;
+    }
+} // namespace
+
+SCENARIO("atomic dex binary wallet config")
+{
+    GIVEN("A wallet config saved in a binary file")
+    {
+        const fs::path folder = fs::temp_directory_path() / fs::unique_path();
+        fs::create_directories(folder);
+        const fs::path path = folder / "roman.wallet.bin";
+
+        atomic_dex::wallet_cfg_store store(8);
+        CHECK_FALSE(store.load(path).has_value());
+        auto cfg = make_wallet_cfg(100);
+        REQUIRE(store.save(cfg));
+        CHECK_EQ(store.get_nb_records(), 1);
+
+        WHEN("I edit the address book")
+        {
+            const auto snapshot_size = fs::file_size(path);
+            cfg.address_book[20].contents[0].address = "RB49Rm4jBe5mN9anErvkzf3kcQCzHqyz3e";
+            cfg.address_book.push_back(atomic_dex::contact{.name = "bob"});
+            cfg.protection_pass = "new_pass";
+            REQUIRE(store.save(cfg));
+            cfg.address_book.erase(cfg.address_book.begin());
+            REQUIRE(store.save(cfg));
+
+            THEN("only change records are appended and the replay gives the same config")
+            {
+                CHECK_EQ(store.get_nb_records(), 5);
+                CHECK_LT(fs::file_size(path) - snapshot_size, 256);
+                atomic_dex::wallet_cfg_store other;
+                auto                         loaded = other.load(path);
+                REQUIRE(loaded.has_value());
+                CHECK_EQ(as_json(loaded.value()), as_json(cfg));
+            }
+
+            AND_WHEN("enough records are appended")
+            {
+                for (std::size_t idx = 0; idx < 10; ++idx)
+                {
+                    cfg.address_book[idx].name += "-renamed";
+                    REQUIRE(store.save(cfg));
+                }
+
+                THEN("the file is compacted into a single snapshot")
+                {
+                    CHECK_LE(store.get_nb_records(), 8);
+                    atomic_dex::wallet_cfg_store other;
+                    CHECK_EQ(as_json(other.load(path).value()), as_json(cfg));
+                }
+            }
+        }
+
+        WHEN("the file ends with a torn record")
+        {
+            cfg.protection_pass = "torn";
+            REQUIRE(store.save(cfg));
+            fs::resize_file(path, fs::file_size(path) - 2);
+
+            THEN("the previous state is loaded and the next save rewrites the file")
+            {
+                atomic_dex::wallet_cfg_store other;
+                auto                         loaded = other.load(path);
+                REQUIRE(loaded.has_value());
+                CHECK_EQ(loaded->protection_pass, "default_protection_pass");
+                REQUIRE(other.save(cfg));
+                CHECK_EQ(other.get_nb_records(), 1);
+                CHECK_EQ(atomic_dex::wallet_cfg_store().load(path)->protection_pass, "torn");
+            }
+        }
+
+        WHEN("a snapshot record in the middle of the file is corrupt")
+        {
+            //! [header][snapshot of cfg] then [corrupt snapshot of another config][set_protection_pass]
+            constexpr std::size_t header_size   = 8;
+            const std::string     first_content = read_file(path);
+            auto                  changed       = cfg;
+            changed.protection_pass             = "after_corruption";
+            REQUIRE(store.save(changed));
+            const std::string pass_record = read_file(path).substr(first_content.size());
+
+            const fs::path               other_path = folder / "other.wallet.bin";
+            atomic_dex::wallet_cfg_store other_store;
+            CHECK_FALSE(other_store.load(other_path).has_value());
+            REQUIRE(other_store.save(make_wallet_cfg(3)));
+            std::string corrupt_snapshot = read_file(other_path).substr(header_size);
+
+            //! type + size, name "roman", protection pass "default_protection_pass", then the number of contacts
+            const std::uint32_t huge_nb_contacts = 0xFFFFFFFF;
+            std::memcpy(corrupt_snapshot.data() + 5 + 9 + 27, &huge_nb_contacts, sizeof(huge_nb_contacts));
+            {
+                std::ofstream ofs(path.string(), std::ios::binary | std::ios::trunc);
+                ofs << first_content << corrupt_snapshot << pass_record;
+            }
+
+            THEN("the state before the corrupt record is kept and written back")
+            {
+                atomic_dex::wallet_cfg_store other;
+                auto                         loaded = other.load(path);
+                REQUIRE(loaded.has_value());
+                CHECK_EQ(as_json(loaded.value()), as_json(cfg));
+                REQUIRE(other.save(loaded.value()));
+                CHECK_EQ(as_json(atomic_dex::wallet_cfg_store().load(path).value()), as_json(cfg));
+            }
+        }
+
+        WHEN("an export path is set")
+        {
+            const fs::path json_path = folder / "roman.wallet.json";
+            store.set_export_path(json_path);
+            cfg.protection_pass = "pass-0";
+            REQUIRE(store.save(cfg));
+            CHECK_FALSE(fs::exists(json_path));
+
+            THEN("the json export is refreshed by every compaction")
+            {
+                for (std::size_t idx = 1; store.get_nb_records() != 1; ++idx)
+                {
+                    cfg.protection_pass = "pass-" + std::to_string(idx);
+                    REQUIRE(store.save(cfg));
+                }
+                auto imported = atomic_dex::wallet_cfg_store::import_json(json_path);
+                REQUIRE(imported.has_value());
+                CHECK_EQ(as_json(imported.value()), as_json(cfg));
+            }
+        }
+
+        WHEN("I export it to json")
+        {
+            const fs::path json_path = folder / "roman.wallet.json";
+            REQUIRE(atomic_dex::wallet_cfg_store::export_json(cfg, json_path));
+
+            THEN("the import gives back the same config")
+            {
+                auto imported = atomic_dex::wallet_cfg_store::import_json(json_path);
+                REQUIRE(imported.has_value());
+                CHECK_EQ(as_json(imported.value()), as_json(cfg));
+            }
+        }
+        fs::remove_all(folder);
+    }
+}